@@ -18,6 +18,7 @@
 #include <experimental/__net_ts/detail/config.hpp>
 #include <cstddef>
 #include <experimental/__net_ts/basic_socket.hpp>
+#include <experimental/__net_ts/buffer.hpp>
 #include <experimental/__net_ts/detail/handler_type_requirements.hpp>
 #include <experimental/__net_ts/detail/throw_error.hpp>
 #include <experimental/__net_ts/detail/type_traits.hpp>
@@ -59,6 +60,36 @@ public:
   /// The endpoint type.
   typedef typename Protocol::endpoint endpoint_type;
 
+#if (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Holds one datagram for async_receive_batch().
+  struct receive_slot
+  {
+    /// The buffer into which the datagram is received.
+    mutable_buffer buffer;
+
+    /// Set to the endpoint of the sender.
+    endpoint_type endpoint;
+
+    /// Set to the number of bytes received.
+    std::size_t size;
+  };
+
+  /// Holds one datagram for async_send_batch().
+  struct send_slot
+  {
+    /// The data to be sent.
+    const_buffer buffer;
+
+    /// The remote endpoint to which the data will be sent.
+    endpoint_type endpoint;
+
+    /// Set to the number of bytes sent.
+    std::size_t size;
+  };
+#endif // (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Construct a basic_datagram_socket without opening it.
   /**
    * This constructor creates a datagram socket without opening it. The open()
@@ -986,6 +1017,222 @@ public:
 
     return init.result.get();
   }
+#if (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a batch of datagrams, each
+   * to its own remote endpoint. Where the platform supports it, many
+   * datagrams are passed to the operating system in a single call. The
+   * function call always returns immediately.
+   *
+   * @param slots A pointer to the first of an array of slots, each of which
+   * holds one datagram and its destination. The @c size member of each slot
+   * is set to the number of bytes sent. Ownership of the slots and of the
+   * memory blocks they refer to is retained by the caller, which must
+   * guarantee that they remain valid until the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const std::error_code& error, // Result of operation.
+   *   std::size_t datagrams         // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * std::experimental::net::io_context::post().
+   *
+   * @note The operation completes when every datagram has been sent or an
+   * error occurs. On error, the first @c datagrams slots have been sent.
+   */
+  template <typename WriteHandler>
+  NET_TS_INITFN_RESULT_TYPE(WriteHandler,
+      void (std::error_code, std::size_t))
+  async_send_batch(send_slot* slots, std::size_t count,
+      NET_TS_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    NET_TS_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    async_completion<WriteHandler,
+      void (std::error_code, std::size_t)> init(handler);
+
+    this->get_service().async_send_batch(
+        this->get_implementation(), slots, count, 0,
+        init.completion_handler);
+
+    return init.result.get();
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a batch of datagrams, each
+   * to its own remote endpoint. Where the platform supports it, many
+   * datagrams are passed to the operating system in a single call. The
+   * function call always returns immediately.
+   *
+   * @param slots A pointer to the first of an array of slots, each of which
+   * holds one datagram and its destination. The @c size member of each slot
+   * is set to the number of bytes sent. Ownership of the slots and of the
+   * memory blocks they refer to is retained by the caller, which must
+   * guarantee that they remain valid until the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const std::error_code& error, // Result of operation.
+   *   std::size_t datagrams         // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * std::experimental::net::io_context::post().
+   *
+   * @note The operation completes when every datagram has been sent or an
+   * error occurs. On error, the first @c datagrams slots have been sent.
+   */
+  template <typename WriteHandler>
+  NET_TS_INITFN_RESULT_TYPE(WriteHandler,
+      void (std::error_code, std::size_t))
+  async_send_batch(send_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      NET_TS_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    NET_TS_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    async_completion<WriteHandler,
+      void (std::error_code, std::size_t)> init(handler);
+
+    this->get_service().async_send_batch(
+        this->get_implementation(), slots, count, flags,
+        init.completion_handler);
+
+    return init.result.get();
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams.
+   * Once at least one datagram is available, datagrams are received until
+   * none remain or every slot has been filled. Where the platform supports
+   * it, many datagrams are received in a single call to the operating
+   * system. The function call always returns immediately.
+   *
+   * @param slots A pointer to the first of an array of slots, each of which
+   * provides the buffer for one datagram. The @c endpoint and @c size members
+   * of each filled slot are set to the sender and the number of bytes
+   * received. Ownership of the slots and of the memory blocks they refer to is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const std::error_code& error, // Result of operation.
+   *   std::size_t datagrams         // Number of slots filled.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * std::experimental::net::io_context::post().
+   *
+   * @par Example
+   * @code
+   * std::vector<char> data(16 * 1500);
+   * udp::socket::receive_slot slots[16];
+   * for (std::size_t i = 0; i < 16; ++i)
+   *   slots[i].buffer = std::experimental::net::buffer(&data[i * 1500], 1500);
+   * socket.async_receive_batch(slots, 16, handler);
+   * @endcode
+   */
+  template <typename ReadHandler>
+  NET_TS_INITFN_RESULT_TYPE(ReadHandler,
+      void (std::error_code, std::size_t))
+  async_receive_batch(receive_slot* slots, std::size_t count,
+      NET_TS_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    NET_TS_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    async_completion<ReadHandler,
+      void (std::error_code, std::size_t)> init(handler);
+
+    this->get_service().async_receive_batch(
+        this->get_implementation(), slots, count, 0,
+        init.completion_handler);
+
+    return init.result.get();
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams.
+   * Once at least one datagram is available, datagrams are received until
+   * none remain or every slot has been filled. Where the platform supports
+   * it, many datagrams are received in a single call to the operating
+   * system. The function call always returns immediately.
+   *
+   * @param slots A pointer to the first of an array of slots, each of which
+   * provides the buffer for one datagram. The @c endpoint and @c size members
+   * of each filled slot are set to the sender and the number of bytes
+   * received. Ownership of the slots and of the memory blocks they refer to is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const std::error_code& error, // Result of operation.
+   *   std::size_t datagrams         // Number of slots filled.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * std::experimental::net::io_context::post().
+   */
+  template <typename ReadHandler>
+  NET_TS_INITFN_RESULT_TYPE(ReadHandler,
+      void (std::error_code, std::size_t))
+  async_receive_batch(receive_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      NET_TS_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    NET_TS_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    async_completion<ReadHandler,
+      void (std::error_code, std::size_t)> init(handler);
+
+    this->get_service().async_receive_batch(
+        this->get_implementation(), slots, count, flags,
+        init.completion_handler);
+
+    return init.result.get();
+  }
+#endif // (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
 };
 
 } // inline namespace v1
@@ -19,6 +19,7 @@
 #include <experimental/__net_ts/async_result.hpp>
 #include <experimental/__net_ts/basic_io_object.hpp>
 #include <experimental/__net_ts/detail/handler_type_requirements.hpp>
+#include <experimental/__net_ts/detail/socket_access.hpp>
 #include <experimental/__net_ts/detail/throw_error.hpp>
 #include <experimental/__net_ts/detail/type_traits.hpp>
 #include <experimental/__net_ts/error.hpp>
@@ -1071,6 +1072,62 @@ public:
     NET_TS_SYNC_OP_VOID_RETURN(ec);
   }
 
+#if (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Change how the socket is registered with the reactor.
+  /**
+   * This function re-registers the socket with the reactor using the
+   * specified flags. It may be called at any time while the socket is open.
+   *
+   * @param flags A combination of socket_base::registration_exclusive and
+   * socket_base::registration_one_shot, or socket_base::registration_default.
+   * The exclusive and one-shot flags cannot be combined.
+   *
+   * @throws std::system_error Thrown on failure.
+   *
+   * @note The flags are implemented by the epoll reactor, using @c
+   * EPOLLEXCLUSIVE and @c EPOLLONESHOT. They are ignored by other reactors.
+   *
+   * @par Example
+   * @code
+   * std::experimental::net::ip::tcp::socket socket(io_context);
+   * ...
+   * socket.set_registration_flags(
+   *     std::experimental::net::socket_base::registration_exclusive);
+   * @endcode
+   */
+  void set_registration_flags(registration_flags flags)
+  {
+    std::error_code ec;
+    this->get_service().set_registration_flags(
+        this->get_implementation(), flags, ec);
+    std::experimental::net::detail::throw_error(ec, "set_registration_flags");
+  }
+
+  /// Change how the socket is registered with the reactor.
+  /**
+   * This function re-registers the socket with the reactor using the
+   * specified flags. It may be called at any time while the socket is open.
+   *
+   * @param flags A combination of socket_base::registration_exclusive and
+   * socket_base::registration_one_shot, or socket_base::registration_default.
+   * The exclusive and one-shot flags cannot be combined.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note The flags are implemented by the epoll reactor, using @c
+   * EPOLLEXCLUSIVE and @c EPOLLONESHOT. They are ignored by other reactors.
+   */
+  NET_TS_SYNC_OP_VOID set_registration_flags(
+      registration_flags flags, std::error_code& ec)
+  {
+    this->get_service().set_registration_flags(
+        this->get_implementation(), flags, ec);
+    NET_TS_SYNC_OP_VOID_RETURN(ec);
+  }
+#endif // (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Gets the non-blocking mode of the native socket implementation.
   /**
    * This function is used to retrieve the non-blocking mode of the underlying
@@ -1615,6 +1672,9 @@ private:
   // Disallow copying and assignment.
   basic_socket(const basic_socket&) NET_TS_DELETED;
   basic_socket& operator=(const basic_socket&) NET_TS_DELETED;
+
+  // The socket services assign accepted connections to the implementation.
+  friend class detail::socket_access;
 };
 
 } // inline namespace v1
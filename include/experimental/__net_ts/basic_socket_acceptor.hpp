@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/detail/config.hpp>
+#include <vector>
 #include <experimental/__net_ts/basic_io_object.hpp>
 #include <experimental/__net_ts/basic_socket.hpp>
 #include <experimental/__net_ts/detail/handler_type_requirements.hpp>
@@ -816,6 +817,61 @@ public:
     NET_TS_SYNC_OP_VOID_RETURN(ec);
   }
 
+#if (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Change how the acceptor is registered with the reactor.
+  /**
+   * This function re-registers the acceptor with the reactor using the
+   * specified flags. It may be called at any time while the acceptor is open.
+   *
+   * @param flags A combination of socket_base::registration_exclusive and
+   * socket_base::registration_one_shot, or socket_base::registration_default.
+   * The exclusive and one-shot flags cannot be combined.
+   *
+   * @throws std::system_error Thrown on failure.
+   *
+   * @note The flags are implemented by the epoll reactor, using @c
+   * EPOLLEXCLUSIVE and @c EPOLLONESHOT. They are ignored by other reactors.
+   *
+   * @par Example
+   * @code
+   * std::experimental::net::ip::tcp::acceptor acceptor(io_context, endpoint);
+   * acceptor.set_registration_flags(
+   *     std::experimental::net::socket_base::registration_exclusive);
+   * @endcode
+   */
+  void set_registration_flags(registration_flags flags)
+  {
+    std::error_code ec;
+    this->get_service().set_registration_flags(
+        this->get_implementation(), flags, ec);
+    std::experimental::net::detail::throw_error(ec, "set_registration_flags");
+  }
+
+  /// Change how the acceptor is registered with the reactor.
+  /**
+   * This function re-registers the acceptor with the reactor using the
+   * specified flags. It may be called at any time while the acceptor is open.
+   *
+   * @param flags A combination of socket_base::registration_exclusive and
+   * socket_base::registration_one_shot, or socket_base::registration_default.
+   * The exclusive and one-shot flags cannot be combined.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note The flags are implemented by the epoll reactor, using @c
+   * EPOLLEXCLUSIVE and @c EPOLLONESHOT. They are ignored by other reactors.
+   */
+  NET_TS_SYNC_OP_VOID set_registration_flags(
+      registration_flags flags, std::error_code& ec)
+  {
+    this->get_service().set_registration_flags(
+        this->get_implementation(), flags, ec);
+    NET_TS_SYNC_OP_VOID_RETURN(ec);
+  }
+#endif // (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Gets the non-blocking mode of the native acceptor implementation.
   /**
    * This function is used to retrieve the non-blocking mode of the underlying
@@ -1569,6 +1625,138 @@ public:
 
     return init.result.get();
   }
+
+#if (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept the connections that are
+   * waiting in the listen queue. When the acceptor becomes ready, connections
+   * are accepted until none remain or @c max_sockets have been accepted, and
+   * they are all passed to a single invocation of the handler. The function
+   * call always returns immediately.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param max_sockets The maximum number of connections to accept. A value
+   * of zero is treated as one, and values greater than
+   * socket_base::max_listen_connections are treated as that limit.
+   *
+   * @param handler The handler to be called when the accept operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const std::error_code& error,
+   *   // The newly accepted sockets, of which there is at least one on
+   *   // success.
+   *   std::vector<typename Protocol::socket> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * std::experimental::net::io_context::post().
+   *
+   * @note An error is reported only when no connection has been accepted.
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const std::error_code& error,
+   *     std::vector<std::experimental::net::ip::tcp::socket> peers)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * std::experimental::net::ip::tcp::acceptor acceptor(io_context);
+   * ...
+   * acceptor.async_accept_many(64, accept_handler);
+   * @endcode
+   */
+  template <typename MoveAcceptHandler>
+  NET_TS_INITFN_RESULT_TYPE(MoveAcceptHandler,
+      void (std::error_code, std::vector<typename Protocol::socket>))
+  async_accept_many(std::size_t max_sockets,
+      NET_TS_MOVE_ARG(MoveAcceptHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a MoveAcceptHandler.
+    NET_TS_MOVE_ACCEPT_HANDLER_CHECK(MoveAcceptHandler,
+        handler, std::vector<typename Protocol::socket>) type_check;
+
+    async_completion<MoveAcceptHandler,
+      void (std::error_code,
+        std::vector<typename Protocol::socket>)> init(handler);
+
+    this->get_service().async_accept_many(this->get_implementation(),
+        static_cast<std::experimental::net::io_context*>(0),
+        max_sockets, init.completion_handler);
+
+    return init.result.get();
+  }
+
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept the connections that are
+   * waiting in the listen queue. When the acceptor becomes ready, connections
+   * are accepted until none remain or @c max_sockets have been accepted, and
+   * they are all passed to a single invocation of the handler. The function
+   * call always returns immediately.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param io_context The io_context object to be used for the newly accepted
+   * sockets.
+   *
+   * @param max_sockets The maximum number of connections to accept. A value
+   * of zero is treated as one, and values greater than
+   * socket_base::max_listen_connections are treated as that limit.
+   *
+   * @param handler The handler to be called when the accept operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const std::error_code& error,
+   *   // The newly accepted sockets, of which there is at least one on
+   *   // success.
+   *   std::vector<typename Protocol::socket> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * std::experimental::net::io_context::post().
+   *
+   * @note An error is reported only when no connection has been accepted.
+   */
+  template <typename MoveAcceptHandler>
+  NET_TS_INITFN_RESULT_TYPE(MoveAcceptHandler,
+      void (std::error_code, std::vector<typename Protocol::socket>))
+  async_accept_many(std::experimental::net::io_context& io_context,
+      std::size_t max_sockets, NET_TS_MOVE_ARG(MoveAcceptHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a MoveAcceptHandler.
+    NET_TS_MOVE_ACCEPT_HANDLER_CHECK(MoveAcceptHandler,
+        handler, std::vector<typename Protocol::socket>) type_check;
+
+    async_completion<MoveAcceptHandler,
+      void (std::error_code,
+        std::vector<typename Protocol::socket>)> init(handler);
+
+    this->get_service().async_accept_many(this->get_implementation(),
+        &io_context, max_sockets, init.completion_handler);
+
+    return init.result.get();
+  }
+#endif // (!defined(NET_TS_HAS_IOCP) && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
 #endif // defined(NET_TS_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 };
 
@@ -19,7 +19,10 @@
 #include <cstddef>
 #include <experimental/__net_ts/async_result.hpp>
 #include <experimental/__net_ts/basic_socket.hpp>
+#include <experimental/__net_ts/detail/chrono.hpp>
+#include <experimental/__net_ts/detail/cstdint.hpp>
 #include <experimental/__net_ts/detail/handler_type_requirements.hpp>
+#include <experimental/__net_ts/detail/limits.hpp>
 #include <experimental/__net_ts/detail/throw_error.hpp>
 #include <experimental/__net_ts/error.hpp>
 
@@ -762,6 +765,51 @@ public:
     return init.result.get();
   }
 
+#if (defined(NET_TS_HAS_CHRONO) && !defined(NET_TS_HAS_IOCP) \
+    && !defined(NET_TS_WINDOWS_RUNTIME)) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous write that fails if it does not complete in time.
+  /**
+   * This function behaves as the overload without a timeout, except that if
+   * the write has not completed when @c timeout has elapsed, the handler is
+   * called with the std::experimental::net::error::timed_out error. The
+   * deadline is kept by the reactor with the operation itself, and so needs no
+   * separate timer or handler. The socket remains open after a timeout.
+   *
+   * @param buffers One or more data buffers to be written to the socket.
+   *
+   * @param timeout The time allowed for the write to complete.
+   *
+   * @param handler The handler to be called when the write operation
+   * completes, with the same signature as for the overload without a timeout.
+   *
+   * @note Deadlines are implemented by the epoll reactor. With other reactors
+   * the operation fails with
+   * std::experimental::net::error::operation_not_supported.
+   */
+  template <typename ConstBufferSequence,
+      typename Rep, typename Period, typename WriteHandler>
+  NET_TS_INITFN_RESULT_TYPE(WriteHandler,
+      void (std::error_code, std::size_t))
+  async_write_some(const ConstBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout,
+      NET_TS_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    NET_TS_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    async_completion<WriteHandler,
+      void (std::error_code, std::size_t)> init(handler);
+
+    this->get_service().async_send(this->get_implementation(),
+        buffers, 0, init.completion_handler, deadline_after(timeout));
+
+    return init.result.get();
+  }
+#endif // (defined(NET_TS_HAS_CHRONO) && !defined(NET_TS_HAS_IOCP)
+       //   && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Read some data from the socket.
   /**
    * This function is used to read data from the stream socket. The function
@@ -879,6 +927,72 @@ public:
 
     return init.result.get();
   }
+
+#if (defined(NET_TS_HAS_CHRONO) && !defined(NET_TS_HAS_IOCP) \
+    && !defined(NET_TS_WINDOWS_RUNTIME)) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous read that fails if it does not complete in time.
+  /**
+   * This function behaves as the overload without a timeout, except that if
+   * no data has been read when @c timeout has elapsed, the handler is called
+   * with the std::experimental::net::error::timed_out error. The deadline is
+   * kept by the reactor with the operation itself, and so needs no separate
+   * timer or handler. The socket remains open after a timeout.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   *
+   * @param timeout The time allowed for the read to complete.
+   *
+   * @param handler The handler to be called when the read operation
+   * completes, with the same signature as for the overload without a timeout.
+   *
+   * @note Deadlines are implemented by the epoll reactor. With other reactors
+   * the operation fails with
+   * std::experimental::net::error::operation_not_supported.
+   *
+   * @par Example
+   * @code
+   * socket.async_read_some(std::experimental::net::buffer(data, size),
+   *     std::chrono::seconds(30), handler);
+   * @endcode
+   */
+  template <typename MutableBufferSequence,
+      typename Rep, typename Period, typename ReadHandler>
+  NET_TS_INITFN_RESULT_TYPE(ReadHandler,
+      void (std::error_code, std::size_t))
+  async_read_some(const MutableBufferSequence& buffers,
+      const chrono::duration<Rep, Period>& timeout,
+      NET_TS_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    NET_TS_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    async_completion<ReadHandler,
+      void (std::error_code, std::size_t)> init(handler);
+
+    this->get_service().async_receive(this->get_implementation(),
+        buffers, 0, init.completion_handler, deadline_after(timeout));
+
+    return init.result.get();
+  }
+
+private:
+  // Convert a timeout to the absolute deadline stored with an operation, in
+  // nanoseconds of the steady clock.
+  template <typename Rep, typename Period>
+  static int64_t deadline_after(const chrono::duration<Rep, Period>& timeout)
+  {
+    int64_t now = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+    if (timeout <= chrono::duration<Rep, Period>::zero())
+      return now;
+    if (timeout > chrono::hours(24 * 365 * 100))
+      return (std::numeric_limits<int64_t>::max)();
+    return now + chrono::duration_cast<chrono::nanoseconds>(timeout).count();
+  }
+#endif // (defined(NET_TS_HAS_CHRONO) && !defined(NET_TS_HAS_IOCP)
+       //   && !defined(NET_TS_WINDOWS_RUNTIME))
+       //   || defined(GENERATING_DOCUMENTATION)
 };
 
 } // inline namespace v1
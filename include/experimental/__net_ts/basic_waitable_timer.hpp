@@ -19,8 +19,10 @@
 #include <cstddef>
 #include <experimental/__net_ts/basic_io_object.hpp>
 #include <experimental/__net_ts/detail/handler_type_requirements.hpp>
+#include <experimental/__net_ts/detail/scoped_ptr.hpp>
 #include <experimental/__net_ts/detail/throw_error.hpp>
 #include <experimental/__net_ts/error.hpp>
+#include <experimental/__net_ts/timer_queue_options.hpp>
 #include <experimental/__net_ts/wait_traits.hpp>
 
 #if defined(NET_TS_HAS_MOVE)
@@ -400,6 +402,69 @@ public:
     return s;
   }
 
+  /// Change the timer's expiry time to an absolute time, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_at(), any pending
+   * asynchronous wait operations are not cancelled, and instead complete when
+   * the new expiry time is reached. This makes it cheap to repeatedly push back
+   * a timeout, such as an idle timeout that is extended whenever data is
+   * received.
+   *
+   * When the expiry time is moved later, the timer is not repositioned among
+   * the pending timers until its previous expiry time is reached.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @throws std::system_error Thrown on failure.
+   *
+   * @note If the timer has already expired when reschedule_at() is called,
+   * then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are passed an error code that indicates the successful
+   * completion of the wait operation.
+   */
+  void reschedule_at(const time_point& expiry_time)
+  {
+    std::error_code ec;
+    this->get_service().reschedule_at(
+        this->get_implementation(), expiry_time, ec);
+    std::experimental::net::detail::throw_error(ec, "reschedule_at");
+  }
+
+  /// Change the timer's expiry time relative to now, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_after(), any pending
+   * asynchronous wait operations are not cancelled, and instead complete when
+   * the new expiry time is reached.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @throws std::system_error Thrown on failure.
+   *
+   * @note If the timer has already expired when reschedule_after() is called,
+   * then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are passed an error code that indicates the successful
+   * completion of the wait operation.
+   */
+  void reschedule_after(const duration& expiry_time)
+  {
+    std::error_code ec;
+    this->get_service().reschedule_after(
+        this->get_implementation(), expiry_time, ec);
+    std::experimental::net::detail::throw_error(ec, "reschedule_after");
+  }
+
   /// Perform a blocking wait on the timer.
   /**
    * This function is used to wait for the timer to expire. This function
@@ -475,6 +540,38 @@ private:
       const basic_waitable_timer&) NET_TS_DELETED;
 };
 
+/// Set the options used to queue timers of the specified type.
+/**
+ * This function sets the options used by an io_context for all timers of the
+ * type @c Timer. It must be called before any timer of that type is created
+ * on the io_context.
+ *
+ * @param ctx The io_context object that runs the timers.
+ *
+ * @param options The options to apply.
+ *
+ * @throws std::experimental::net::service_already_exists Thrown if timers of
+ * the type @c Timer have already been used with the io_context.
+ *
+ * @par Example
+ * @code std::experimental::net::set_timer_queue_options<
+ *     std::experimental::net::steady_timer>(my_io_context,
+ *       std::experimental::net::timer_queue_options().use_timer_wheel(
+ *         std::chrono::milliseconds(1))); @endcode
+ */
+template <typename Timer>
+void set_timer_queue_options(std::experimental::net::io_context& ctx,
+    const timer_queue_options& options)
+{
+  typedef detail::deadline_timer_service<
+    detail::chrono_time_traits<typename Timer::clock_type,
+      typename Timer::traits_type> > service_type;
+
+  detail::scoped_ptr<service_type> svc(new service_type(ctx, options));
+  std::experimental::net::add_service(ctx, svc.get());
+  svc.release();
+}
+
 } // inline namespace v1
 } // namespace net
 } // namespace experimental
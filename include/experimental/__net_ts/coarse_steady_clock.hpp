@@ -0,0 +1,85 @@
+//
+// coarse_steady_clock.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_COARSE_STEADY_CLOCK_HPP
+#define NET_TS_COARSE_STEADY_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include <experimental/__net_ts/detail/chrono.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// A monotonic clock that trades precision for a cheaper now().
+/**
+ * The coarse_steady_clock class meets the requirements of a steady clock, and
+ * is intended for timeouts that do not need to be precise.
+ *
+ * When called from a thread that is running an io_context, now() returns the
+ * time cached for the current step of the event loop. The cache is discarded
+ * each time the thread starts to run a handler and each time it returns from
+ * waiting in the reactor, so the clock is read at most once per step, no
+ * matter how many timers are set or checked.
+ *
+ * Otherwise, and whenever the cache is empty, the time is read from
+ * @c CLOCK_MONOTONIC_COARSE where that is available, and from the steady
+ * clock elsewhere. The coarse clock typically has a resolution of a few
+ * milliseconds.
+ *
+ * @note Because each thread keeps its own cached time, values obtained in
+ * different threads at about the same moment may be slightly out of order.
+ */
+class coarse_steady_clock
+{
+public:
+  /// The type used to represent durations of the clock.
+  typedef chrono::nanoseconds duration;
+
+  /// The arithmetic type used to count ticks of the clock.
+  typedef duration::rep rep;
+
+  /// The tick period of the clock, in seconds.
+  typedef duration::period period;
+
+  /// The type used to represent points in time of the clock.
+  typedef chrono::time_point<coarse_steady_clock> time_point;
+
+  /// The clock never goes backwards.
+  static const bool is_steady = true;
+
+  /// Obtain the current time.
+  NET_TS_DECL static time_point now() NET_TS_NOEXCEPT;
+};
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#if defined(NET_TS_HEADER_ONLY)
+# include <experimental/__net_ts/impl/coarse_steady_clock.ipp>
+#endif // defined(NET_TS_HEADER_ONLY)
+
+#endif // defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // NET_TS_COARSE_STEADY_CLOCK_HPP
@@ -0,0 +1,45 @@
+//
+// coarse_steady_timer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_COARSE_STEADY_TIMER_HPP
+#define NET_TS_COARSE_STEADY_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include <experimental/__net_ts/basic_waitable_timer.hpp>
+#include <experimental/__net_ts/coarse_steady_clock.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// Typedef for a timer based on the coarse steady clock.
+/**
+ * This timer suits large numbers of timeouts that need not be precise, such
+ * as idle or request timeouts. Measured against a precise clock, it may fire
+ * early or late by about the resolution of the coarse clock.
+ */
+typedef basic_waitable_timer<coarse_steady_clock> coarse_steady_timer;
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#endif // defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // NET_TS_COARSE_STEADY_TIMER_HPP
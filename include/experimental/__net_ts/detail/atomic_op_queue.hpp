@@ -0,0 +1,118 @@
+//
+// detail/atomic_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_ATOMIC_OP_QUEUE_HPP
+#define NET_TS_DETAIL_ATOMIC_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <cstddef>
+#include <experimental/__net_ts/detail/noncopyable.hpp>
+#include <experimental/__net_ts/detail/op_queue.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+// A lock-free queue of operations that may be pushed to by any number of
+// threads concurrently, but is emptied by only one thread at a time.
+// Operations are pushed on to an intrusive stack, and are put back into
+// first-in-first-out order when the queue is emptied.
+template <typename Operation>
+class atomic_op_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  atomic_op_queue()
+    : top_(0)
+  {
+  }
+
+  // Destructor destroys all operations.
+  ~atomic_op_queue()
+  {
+    op_queue<Operation> ops;
+    pop_all(ops);
+  }
+
+  // Push an operation. Returns true if the queue was previously empty.
+  bool push(Operation* h)
+  {
+    Operation* top = top_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(h, top);
+    } while (!top_.compare_exchange_weak(top, h,
+          std::memory_order_seq_cst, std::memory_order_relaxed));
+    return top == 0;
+  }
+
+  // Whether the queue is empty.
+  bool empty() const
+  {
+    return top_.load(std::memory_order_seq_cst) == 0;
+  }
+
+  // Move all operations on to the back of another queue, oldest first, and
+  // return how many were moved. Must not be called concurrently with itself.
+  std::size_t pop_all(op_queue<Operation>& q)
+  {
+    Operation* top = top_.exchange(0, std::memory_order_acquire);
+
+    // Reverse the stack so that the operations are in the order in which they
+    // were pushed.
+    Operation* front = 0;
+    while (top)
+    {
+      Operation* next = op_queue_access::next(top);
+      op_queue_access::next(top, front);
+      front = top;
+      top = next;
+    }
+
+    std::size_t n = 0;
+    while (front)
+    {
+      Operation* next = op_queue_access::next(front);
+      q.push(front);
+      front = next;
+      ++n;
+    }
+    return n;
+  }
+
+private:
+  // The most recently pushed operation.
+  std::atomic<Operation*> top_;
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+
+#endif // NET_TS_DETAIL_ATOMIC_OP_QUEUE_HPP
@@ -29,6 +29,15 @@
 // If set, this bit indicates that the reactor should perform locking.
 #define NET_TS_CONCURRENCY_HINT_LOCKING_REACTOR 0x2u
 
+// If set, this bit indicates that the scheduler should give each thread a
+// local run queue, and that idle threads should steal from their peers.
+#define NET_TS_CONCURRENCY_HINT_WORK_STEALING_SCHEDULER 0x4u
+
+// These bits hold the number of epoll instances across which the reactor
+// should shard descriptors. A value of 0 or 1 means no sharding.
+#define NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS_MASK 0xFF00u
+#define NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS_SHIFT 8
+
 // Helper macro to determine if we have a special concurrency hint.
 #define NET_TS_CONCURRENCY_HINT_IS_SPECIAL(hint) \
   ((static_cast<unsigned>(hint) \
@@ -42,6 +51,19 @@
       | NET_TS_CONCURRENCY_HINT_LOCKING_ ## facility)) \
         ^ NET_TS_CONCURRENCY_HINT_ID) != 0)
 
+// Helper macro to determine if work stealing is enabled in the scheduler.
+#define NET_TS_CONCURRENCY_HINT_IS_WORK_STEALING(hint) \
+  (NET_TS_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && ((static_cast<unsigned>(hint) \
+      & NET_TS_CONCURRENCY_HINT_WORK_STEALING_SCHEDULER) != 0))
+
+// Helper macro to get the number of reactor shards for a given hint.
+#define NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS(hint) \
+  (NET_TS_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    ? ((static_cast<unsigned>(hint) \
+      & NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS_MASK) \
+        >> NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS_SHIFT) : 0u)
+
 // This special concurrency hint disables locking in both the scheduler and
 // reactor I/O. This hint has the following restrictions:
 //
@@ -72,6 +94,32 @@
       | NET_TS_CONCURRENCY_HINT_LOCKING_SCHEDULER \
       | NET_TS_CONCURRENCY_HINT_LOCKING_REACTOR)
 
+// This special concurrency hint provides full thread safety, and additionally
+// gives each thread running the io_context its own run queue. Handlers posted
+// from within a handler are kept on the posting thread's queue, and threads
+// that run out of work steal from their peers before blocking. This reduces
+// contention on the scheduler's shared queue when many threads call run().
+#define NET_TS_CONCURRENCY_HINT_SAFE_WORK_STEALING \
+  static_cast<int>(NET_TS_CONCURRENCY_HINT_ID \
+      | NET_TS_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | NET_TS_CONCURRENCY_HINT_LOCKING_REACTOR \
+      | NET_TS_CONCURRENCY_HINT_WORK_STEALING_SCHEDULER)
+
+// This special concurrency hint provides full thread safety, and additionally
+// spreads the descriptors registered with the reactor across the specified
+// number of epoll instances, from 1 to 255. The events for each instance are
+// collected independently, so that multiple threads running the io_context
+// can harvest readiness events in parallel. The hint is only honoured by the
+// epoll-based reactor, and is otherwise equivalent to
+// NET_TS_CONCURRENCY_HINT_SAFE.
+#define NET_TS_CONCURRENCY_HINT_SAFE_SHARDED(shards) \
+  static_cast<int>(NET_TS_CONCURRENCY_HINT_ID \
+      | NET_TS_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | NET_TS_CONCURRENCY_HINT_LOCKING_REACTOR \
+      | ((static_cast<unsigned>(shards) \
+          << NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS_SHIFT) \
+        & NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS_MASK))
+
 // This #define may be overridden at compile time to specify a program-wide
 // default concurrency hint, used by the zero-argument io_context constructor.
 #if !defined(NET_TS_CONCURRENCY_HINT_DEFAULT)
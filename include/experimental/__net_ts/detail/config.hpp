@@ -466,6 +466,15 @@
         // || defined(NET_TS_HAS_BOOST_CHRONO)
 #endif // !defined(NET_TS_HAS_CHRONO)
 
+// Per-thread io_context statistics counters. Must be explicitly enabled.
+#if !defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+# if defined(NET_TS_ENABLE_IO_CONTEXT_STATISTICS)
+#  if defined(NET_TS_HAS_STD_ATOMIC) && defined(NET_TS_HAS_CHRONO)
+#   define NET_TS_HAS_IO_CONTEXT_STATISTICS 1
+#  endif // defined(NET_TS_HAS_STD_ATOMIC) && defined(NET_TS_HAS_CHRONO)
+# endif // defined(NET_TS_ENABLE_IO_CONTEXT_STATISTICS)
+#endif // !defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
 // Boost support for the DateTime library.
 #if !defined(NET_TS_HAS_BOOST_DATE_TIME)
 # if !defined(NET_TS_DISABLE_BOOST_DATE_TIME)
@@ -884,7 +893,7 @@
 # include <unistd.h>
 #endif // defined(NET_TS_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd, io_uring and non-blocking socket creation.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(NET_TS_HAS_EPOLL)
@@ -908,6 +917,27 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(NET_TS_HAS_EPOLL)
 # endif // !defined(NET_TS_HAS_TIMERFD)
+# if !defined(NET_TS_HAS_IO_URING)
+#  if defined(NET_TS_ENABLE_IO_URING)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,11,0)
+#    define NET_TS_HAS_IO_URING 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,11,0)
+#  endif // defined(NET_TS_ENABLE_IO_URING)
+# endif // !defined(NET_TS_HAS_IO_URING)
+# if !defined(NET_TS_HAS_SOCK_NONBLOCK)
+#  if !defined(NET_TS_DISABLE_SOCK_NONBLOCK)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#    define NET_TS_HAS_SOCK_NONBLOCK 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#  endif // !defined(NET_TS_DISABLE_SOCK_NONBLOCK)
+# endif // !defined(NET_TS_HAS_SOCK_NONBLOCK)
+# if !defined(NET_TS_HAS_MMSG)
+#  if !defined(NET_TS_DISABLE_MMSG)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#    define NET_TS_HAS_MMSG 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#  endif // !defined(NET_TS_DISABLE_MMSG)
+# endif // !defined(NET_TS_HAS_MMSG)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -1114,6 +1144,17 @@
 # endif // defined(NET_TS_HAS_THREADS)
 #endif // !defined(NET_TS_HAS_PTHREADS)
 
+// Binary handler tracking. Must be explicitly enabled.
+#if !defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+# if defined(NET_TS_ENABLE_BINARY_HANDLER_TRACKING)
+#  if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC) \
+     && defined(NET_TS_HAS_CHRONO)
+#   define NET_TS_HAS_BINARY_HANDLER_TRACKING 1
+#  endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+         //   && defined(NET_TS_HAS_CHRONO)
+# endif // defined(NET_TS_ENABLE_BINARY_HANDLER_TRACKING)
+#endif // !defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+
 // Helper to prevent macro expansion.
 #define NET_TS_PREVENT_MACRO_SUBSTITUTION
 
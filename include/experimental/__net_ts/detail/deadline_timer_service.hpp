@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <experimental/__net_ts/error.hpp>
 #include <experimental/__net_ts/io_context.hpp>
+#include <experimental/__net_ts/timer_queue_options.hpp>
 #include <experimental/__net_ts/detail/bind_handler.hpp>
 #include <experimental/__net_ts/detail/fenced_block.hpp>
 #include <experimental/__net_ts/detail/memory.hpp>
@@ -74,6 +75,21 @@ public:
     scheduler_.add_timer_queue(timer_queue_);
   }
 
+  // Constructor that applies the specified queueing options.
+  deadline_timer_service(std::experimental::net::io_context& io_context,
+      const timer_queue_options& options)
+    : service_base<deadline_timer_service<Time_Traits> >(io_context),
+      scheduler_(std::experimental::net::use_service<timer_scheduler>(io_context))
+  {
+    if (options.uses_timer_wheel())
+      timer_queue_.use_wheel(options.timer_wheel_resolution_usec(),
+          options.timer_wheel_slots(), options.timer_wheel_levels());
+    if (options.timer_slack_usec() > 0)
+      timer_queue_.set_slack(options.timer_slack_usec());
+    scheduler_.init_task();
+    scheduler_.add_timer_queue(timer_queue_);
+  }
+
   // Destructor.
   ~deadline_timer_service()
   {
@@ -198,6 +214,31 @@ public:
     return count;
   }
 
+  // Set the expiry time for the timer as an absolute time, without cancelling
+  // any pending waits.
+  void reschedule_at(implementation_type& impl,
+      const time_type& expiry_time, std::error_code& ec)
+  {
+    if (impl.might_have_pending_waits)
+    {
+      NET_TS_HANDLER_OPERATION((scheduler_.context(),
+            "deadline_timer", &impl, 0, "reschedule"));
+
+      scheduler_.reschedule_timer(timer_queue_, impl.timer_data, expiry_time);
+    }
+
+    impl.expiry = expiry_time;
+    ec = std::error_code();
+  }
+
+  // Set the expiry time for the timer relative to now, without cancelling any
+  // pending waits.
+  void reschedule_after(implementation_type& impl,
+      const duration_type& expiry_time, std::error_code& ec)
+  {
+    reschedule_at(impl, Time_Traits::add(Time_Traits::now(), expiry_time), ec);
+  }
+
   // Set the expiry time for the timer relative to now.
   std::size_t expires_after(implementation_type& impl,
       const duration_type& expiry_time, std::error_code& ec)
@@ -20,6 +20,8 @@
 #if defined(NET_TS_HAS_EPOLL)
 
 #include <experimental/__net_ts/detail/atomic_count.hpp>
+#include <experimental/__net_ts/detail/chrono.hpp>
+#include <experimental/__net_ts/detail/chrono_time_traits.hpp>
 #include <experimental/__net_ts/detail/conditionally_enabled_mutex.hpp>
 #include <experimental/__net_ts/detail/limits.hpp>
 #include <experimental/__net_ts/detail/object_pool.hpp>
@@ -27,10 +29,12 @@
 #include <experimental/__net_ts/detail/reactor_op.hpp>
 #include <experimental/__net_ts/detail/select_interrupter.hpp>
 #include <experimental/__net_ts/detail/socket_types.hpp>
+#include <experimental/__net_ts/detail/timer_queue.hpp>
 #include <experimental/__net_ts/detail/timer_queue_base.hpp>
 #include <experimental/__net_ts/detail/timer_queue_set.hpp>
 #include <experimental/__net_ts/detail/wait_op.hpp>
 #include <experimental/__net_ts/execution_context.hpp>
+#include <experimental/__net_ts/wait_traits.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
 
@@ -47,6 +51,11 @@ private:
   // The mutex type used by this reactor.
   typedef conditionally_enabled_mutex mutex;
 
+  // The timer queue used to expire operation deadlines.
+  typedef timer_queue<chrono_time_traits<chrono::steady_clock,
+      std::experimental::net::wait_traits<chrono::steady_clock> > >
+    deadline_queue;
+
 public:
   enum op_types { read_op = 0, write_op = 1,
     connect_op = 1, except_op = 2, max_ops = 3 };
@@ -63,11 +72,37 @@ public:
     mutex mutex_;
     epoll_reactor* reactor_;
     int descriptor_;
+    std::size_t shard_;
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
     bool shutdown_;
 
+    // Completes the descriptor's operations whose deadlines have passed.
+    class deadline_op : public wait_op
+    {
+    public:
+      explicit deadline_op(descriptor_state* state)
+        : wait_op(&deadline_op::do_complete),
+          state_(state)
+      {
+      }
+
+      NET_TS_DECL static void do_complete(
+          void* owner, operation* base,
+          const std::error_code& ec, std::size_t bytes_transferred);
+
+    private:
+      descriptor_state* state_;
+    };
+
+    deadline_op deadline_op_;
+    deadline_queue::per_timer_data deadline_timer_;
+
+    // The deadline for which the timer has been armed, or zero if the timer
+    // is neither queued nor waiting to run.
+    int64_t deadline_;
+
     NET_TS_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     NET_TS_DECL operation* perform_io(uint32_t events);
@@ -79,6 +114,23 @@ public:
   // Per-descriptor data.
   typedef descriptor_state* per_descriptor_data;
 
+  // An additional epoll instance, used when descriptors are sharded. The
+  // shard's epoll descriptor is itself registered with the main epoll
+  // descriptor, and the shard is queued as an operation whenever it has
+  // events to be drained.
+  class shard_state : operation
+  {
+    friend class epoll_reactor;
+
+    epoll_reactor* reactor_;
+    int epoll_fd_;
+
+    NET_TS_DECL shard_state();
+    NET_TS_DECL static void do_complete(
+        void* owner, operation* base,
+        const std::error_code& ec, std::size_t bytes_transferred);
+  };
+
   // Constructor.
   NET_TS_DECL epoll_reactor(std::experimental::net::execution_context& ctx);
 
@@ -111,6 +163,11 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Change the flags used to register the descriptor. Returns 0 on success,
+  // system error code on failure.
+  NET_TS_DECL int set_registration_flags(socket_type descriptor,
+      per_descriptor_data& descriptor_data, int flags);
+
   // Post a reactor operation for immediate completion.
   void post_immediate_completion(reactor_op* op, bool is_continuation)
   {
@@ -166,8 +223,17 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Change the expiry time of the given timer without cancelling the
+  // operations waiting on it.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Run epoll once until interrupted or events are ready to be dispatched.
-  NET_TS_DECL void run(long usec, op_queue<operation>& ops);
+  // Returns the number of events found, counting each ready descriptor and
+  // each expired timer.
+  NET_TS_DECL std::size_t run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   NET_TS_DECL void interrupt();
@@ -183,12 +249,55 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   NET_TS_DECL static int do_timerfd_create();
 
+  // Create the additional epoll instances for sharding and register them
+  // with the main epoll descriptor. Does not throw.
+  NET_TS_DECL void create_shards();
+
+  // Close the additional epoll instances.
+  NET_TS_DECL void destroy_shards();
+
+  // Get the epoll descriptor with which a descriptor is registered.
+  int shard_epoll_fd(descriptor_state* descriptor_data) const
+  {
+    return descriptor_data->shard_ == 0
+      ? epoll_fd_ : shards_[descriptor_data->shard_ - 1].epoll_fd_;
+  }
+
+  // Whether a descriptor was registered with EPOLLEXCLUSIVE. The descriptor
+  // mutex must be held.
+  NET_TS_DECL static bool is_exclusive_registration(
+      descriptor_state* descriptor_data);
+
+  // Find the shard to which an event on the main epoll descriptor refers.
+  // Returns 0 if the event does not refer to a shard.
+  NET_TS_DECL shard_state* find_shard(void* ptr) const;
+
+  // Collect the events from a shard's epoll instance without blocking.
+  NET_TS_DECL void drain_shard(shard_state* shard);
+
   // Allocate a new descriptor state object.
   NET_TS_DECL descriptor_state* allocate_descriptor_state();
 
   // Free an existing descriptor state object.
   NET_TS_DECL void free_descriptor_state(descriptor_state* s);
 
+  // Get the current time in the units used for operation deadlines.
+  NET_TS_DECL static int64_t deadline_now();
+
+  // Arm the descriptor's deadline timer, unless it is already armed for an
+  // earlier time. The descriptor's mutex must be held.
+  NET_TS_DECL void arm_deadline(descriptor_state* s, int64_t deadline);
+
+  // Remove the descriptor's deadline timer from the queue. Returns false if
+  // the timer has already fired and its operation is still to run. The
+  // descriptor's mutex must be held.
+  NET_TS_DECL bool disarm_deadline(descriptor_state* s);
+
+  // Complete the operations whose deadlines have passed with the timed_out
+  // error, and re-arm the timer for those that remain. A descriptor state
+  // whose deregistration was waiting for the deadline operation is freed.
+  NET_TS_DECL void expire_deadlines(descriptor_state* s);
+
   // Helper function to add a new timer queue.
   NET_TS_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -224,9 +333,21 @@ private:
   // The timer file descriptor.
   int timer_fd_;
 
+  // The total number of shards, including the main epoll descriptor.
+  std::size_t shard_count_;
+
+  // The additional shards. Null if descriptors are not sharded.
+  shard_state* shards_;
+
+  // Used to assign new descriptors to shards in round-robin order.
+  atomic_count next_shard_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
+  // The timer queue for operation deadlines.
+  deadline_queue deadline_queue_;
+
   // Whether the service has been shut down.
   bool shutdown_;
 
@@ -29,9 +29,18 @@ class execution_context;
 } // namespace experimental
 } // namespace std
 
+#if defined(NET_TS_HAS_BINARY_HANDLER_TRACKING) \
+  && !defined(NET_TS_CUSTOM_HANDLER_TRACKING)
+# if !defined(NET_TS_ENABLE_HANDLER_TRACKING)
+#  define NET_TS_ENABLE_HANDLER_TRACKING 1
+# endif // !defined(NET_TS_ENABLE_HANDLER_TRACKING)
+#endif // defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+       //   && !defined(NET_TS_CUSTOM_HANDLER_TRACKING)
+
 #if defined(NET_TS_CUSTOM_HANDLER_TRACKING)
 # include NET_TS_CUSTOM_HANDLER_TRACKING
 #elif defined(NET_TS_ENABLE_HANDLER_TRACKING)
+# include <iosfwd>
 # include <system_error>
 # include <experimental/__net_ts/detail/cstdint.hpp>
 # include <experimental/__net_ts/detail/static_mutex.hpp>
@@ -71,6 +80,13 @@ namespace detail {
 
 #elif defined(NET_TS_ENABLE_HANDLER_TRACKING)
 
+// Records the life cycle of handlers. By default, each event is written as a
+// line of text to standard error. If NET_TS_ENABLE_BINARY_HANDLER_TRACKING is
+// defined, events are instead recorded in per-thread ring buffers, which are
+// written to a binary file by a background thread. The file is named by the
+// NET_TS_HANDLER_TRACKING_FILE environment variable, or is
+// "handler_tracking.bin" in the current directory, and may be converted to
+// the Chrome trace event format with export_chrome_trace().
 class handler_tracking
 {
 public:
@@ -170,6 +186,18 @@ public:
   // Write a line of output.
   NET_TS_DECL static void write_line(const char* format, ...);
 
+#if defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+  // Write any events that have been recorded but not yet written to the
+  // binary file.
+  NET_TS_DECL static void flush();
+
+  // Convert the contents of a binary file, written by the same build of the
+  // program, to Chrome trace event JSON. Returns false if the input is not a
+  // binary handler tracking file.
+  NET_TS_DECL static bool export_chrome_trace(
+      std::istream& in, std::ostream& out);
+#endif // defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+
 private:
   struct tracking_state;
   NET_TS_DECL static tracking_state* get_state();
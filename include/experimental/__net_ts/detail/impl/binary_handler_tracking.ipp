@@ -0,0 +1,876 @@
+//
+// detail/impl/binary_handler_tracking.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_IMPL_BINARY_HANDLER_TRACKING_IPP
+#define NET_TS_DETAIL_IMPL_BINARY_HANDLER_TRACKING_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <experimental/__net_ts/detail/chrono.hpp>
+#include <experimental/__net_ts/detail/event.hpp>
+#include <experimental/__net_ts/detail/handler_tracking.hpp>
+#include <experimental/__net_ts/detail/mutex.hpp>
+#include <experimental/__net_ts/detail/noncopyable.hpp>
+#include <experimental/__net_ts/detail/scoped_ptr.hpp>
+#include <experimental/__net_ts/detail/thread.hpp>
+#include <experimental/__net_ts/detail/tss_ptr.hpp>
+
+#if !defined(NET_TS_HANDLER_TRACKING_RING_SIZE)
+# define NET_TS_HANDLER_TRACKING_RING_SIZE 8192
+#endif // !defined(NET_TS_HANDLER_TRACKING_RING_SIZE)
+
+#if !defined(NET_TS_HANDLER_TRACKING_FLUSH_USEC)
+# define NET_TS_HANDLER_TRACKING_FLUSH_USEC 100000
+#endif // !defined(NET_TS_HANDLER_TRACKING_FLUSH_USEC)
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+// A single recorded event. Strings are recorded as the addresses of string
+// literals, and each is written to the file once, the first time it is seen.
+struct handler_tracking_event
+{
+  enum flags_type { has_error = 1, has_argument = 2 };
+
+  uint64_t timestamp;
+  uint64_t id;
+  uint64_t parent_id;
+  uint64_t object;
+  uint64_t object_type;
+  uint64_t op_name;
+  uint64_t category;
+  uint64_t argument;
+  int32_t error;
+  uint32_t thread;
+  uint16_t kind;
+  uint16_t flags;
+  uint32_t reserved;
+};
+
+// Tags that introduce each record in the binary file.
+enum handler_tracking_record
+{
+  handler_tracking_string_record = 'S',
+  handler_tracking_event_record = 'E',
+  handler_tracking_dropped_record = 'D'
+};
+
+static const char handler_tracking_magic[8] =
+  { 'N', 'E', 'T', 'T', 'S', 'H', 'T', '1' };
+
+// Ring buffer of events recorded by a single thread. Events are pushed only
+// by the owning thread and popped only by the flushing thread. If the buffer
+// is full, new events are counted and discarded. When the owning thread
+// exits, the ring is released so that it can be reused by a new thread once
+// the flushing thread has emptied it.
+class handler_tracking_ring
+  : private noncopyable
+{
+public:
+  enum { capacity = NET_TS_HANDLER_TRACKING_RING_SIZE };
+
+  explicit handler_tracking_ring(uint32_t thread)
+    : next_(0),
+      head_(0),
+      tail_(0),
+      dropped_(0),
+      reported_dropped_(0),
+      thread_(thread),
+      owned_(true)
+  {
+  }
+
+  uint32_t thread() const
+  {
+    return thread_;
+  }
+
+  // Give up ownership of the ring. Called by the owning thread as it exits.
+  void release()
+  {
+    owned_.store(false, std::memory_order_release);
+  }
+
+  // Take ownership of a released ring on behalf of a new thread, if all of
+  // its events have been flushed. Must be called with the tracking state's
+  // mutex held, so that it does not race with the flushing thread or with
+  // another claim.
+  bool try_claim(uint32_t thread)
+  {
+    if (owned_.load(std::memory_order_acquire)
+        || head_.load(std::memory_order_relaxed)
+          != tail_.load(std::memory_order_relaxed)
+        || dropped_.load(std::memory_order_relaxed) != reported_dropped_)
+      return false;
+
+    owned_.store(true, std::memory_order_relaxed);
+    thread_ = thread;
+    return true;
+  }
+
+  // Returns true if the push filled the buffer to half its capacity, in which
+  // case the flushing thread should be woken rather than left to its timer.
+  bool push(handler_tracking_event& e)
+  {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t size = head - tail_.load(std::memory_order_acquire);
+    if (size == capacity)
+    {
+      dropped_.store(dropped_.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      return false;
+    }
+
+    e.thread = thread_;
+    events_[head % capacity] = e;
+    head_.store(head + 1, std::memory_order_release);
+    return size + 1 == capacity / 2;
+  }
+
+  void pop_all(std::vector<handler_tracking_event>& events)
+  {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    for (; tail != head; ++tail)
+      events.push_back(events_[tail % capacity]);
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  // Returns the number of events dropped since the last call.
+  uint64_t take_dropped()
+  {
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    uint64_t n = dropped - reported_dropped_;
+    reported_dropped_ = dropped;
+    return n;
+  }
+
+  handler_tracking_ring* next_;
+
+private:
+  std::atomic<uint64_t> head_;
+  std::atomic<uint64_t> tail_;
+  std::atomic<uint64_t> dropped_;
+  uint64_t reported_dropped_;
+  uint32_t thread_;
+  std::atomic<bool> owned_;
+  handler_tracking_event events_[capacity];
+};
+
+// Holds the calling thread's ring, and releases it when the thread exits.
+struct handler_tracking_ring_owner
+{
+  handler_tracking_ring* ring_;
+
+  ~handler_tracking_ring_owner()
+  {
+    if (ring_)
+      ring_->release();
+    ring_ = 0;
+  }
+};
+
+struct handler_tracking::tracking_state
+{
+  tracking_state()
+    : next_id_(1),
+      flush_requested_(false),
+      flushing_(false),
+      next_thread_(1),
+      rings_(0),
+      stopping_(false),
+      file_(0)
+  {
+    const char* path = std::getenv("NET_TS_HANDLER_TRACKING_FILE");
+    file_ = std::fopen(path ? path : "handler_tracking.bin", "wb");
+    if (file_)
+    {
+      uint32_t event_size = sizeof(handler_tracking_event);
+      std::fwrite(handler_tracking_magic, sizeof(handler_tracking_magic), 1,
+          file_);
+      std::fwrite(&event_size, sizeof(event_size), 1, file_);
+    }
+
+    flusher_function f = { this };
+    flusher_.reset(new thread(f));
+  }
+
+  ~tracking_state()
+  {
+    mutex::scoped_lock lock(mutex_);
+    stopping_ = true;
+    wakeup_.signal_all(lock);
+    lock.unlock();
+
+    flusher_->join();
+
+    lock.lock();
+    flush(lock);
+    if (file_)
+      std::fclose(file_);
+    file_ = 0;
+
+    // The rings are deliberately not freed, as handlers may still be tracked
+    // from objects that are destroyed after this one, and threads that are
+    // still running release their rings when they exit.
+  }
+
+  // Get the calling thread's ring buffer. A new thread takes over the ring of
+  // a thread that has exited if there is one, and otherwise creates a ring.
+  handler_tracking_ring* ring()
+  {
+    static thread_local handler_tracking_ring_owner owner;
+    handler_tracking_ring* r = owner.ring_;
+    if (!r)
+    {
+      mutex::scoped_lock lock(mutex_);
+      uint32_t thread = next_thread_++;
+      for (r = rings_; r; r = r->next_)
+        if (r->try_claim(thread))
+          break;
+      if (!r)
+      {
+        r = new handler_tracking_ring(thread);
+        r->next_ = rings_;
+        rings_ = r;
+      }
+      owner.ring_ = r;
+    }
+    return r;
+  }
+
+  // Record an event on the calling thread.
+  void record(handler_tracking_event& e)
+  {
+    e.timestamp = static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(
+          chrono::steady_clock::now().time_since_epoch()).count());
+    if (ring()->push(e))
+      request_flush();
+  }
+
+  // Wake the flushing thread early. Only the first request made after each
+  // flush takes the mutex, and not even that one if a flush is in progress,
+  // as the flusher checks for requests before it next waits.
+  void request_flush()
+  {
+    if (!flush_requested_.exchange(true) && !flushing_.load())
+    {
+      mutex::scoped_lock lock(mutex_);
+      wakeup_.signal_all(lock);
+    }
+  }
+
+  // Append raw bytes to the output buffer.
+  void append(const void* data, std::size_t length)
+  {
+    const char* p = static_cast<const char*>(data);
+    buffer_.insert(buffer_.end(), p, p + length);
+  }
+
+  // Write the address and contents of a string, if not already written. The
+  // last key seen is remembered, as consecutive events usually share it.
+  void write_string(uint64_t& last_key, uint64_t key, const char* s)
+  {
+    if (key == 0 || key == last_key)
+      return;
+    last_key = key;
+    if (!strings_.insert(key).second)
+      return;
+
+    unsigned char tag = handler_tracking_string_record;
+    uint32_t length = static_cast<uint32_t>(std::strlen(s));
+    append(&tag, 1);
+    append(&key, sizeof(key));
+    append(&length, sizeof(length));
+    append(s, length);
+  }
+
+  // Write out all recorded events. Must be called with the mutex held.
+  void flush(mutex::scoped_lock&)
+  {
+    // Empty every ring before writing anything, so that no ring is left to
+    // fill up while the events of the others are written.
+    events_.clear();
+    dropped_.clear();
+    for (handler_tracking_ring* r = rings_; r; r = r->next_)
+    {
+      r->pop_all(events_);
+      if (uint64_t dropped = r->take_dropped())
+        dropped_.push_back(std::make_pair(r->thread(), dropped));
+    }
+
+    if (!file_)
+      return;
+
+    // The records are built up in memory and written with a single call.
+    buffer_.clear();
+    uint64_t last_object_type = 0, last_op_name = 0, last_category = 0;
+    for (std::size_t i = 0; i < events_.size(); ++i)
+    {
+      const handler_tracking_event& e = events_[i];
+      write_string(last_object_type, e.object_type,
+          reinterpret_cast<const char*>(e.object_type));
+      write_string(last_op_name, e.op_name,
+          reinterpret_cast<const char*>(e.op_name));
+      if (e.category)
+        write_string(last_category, e.category, reinterpret_cast<
+            const std::error_category*>(e.category)->name());
+
+      unsigned char tag = handler_tracking_event_record;
+      append(&tag, 1);
+      append(&e, sizeof(e));
+    }
+
+    for (std::size_t i = 0; i < dropped_.size(); ++i)
+    {
+      unsigned char tag = handler_tracking_dropped_record;
+      append(&tag, 1);
+      append(&dropped_[i].first, sizeof(uint32_t));
+      append(&dropped_[i].second, sizeof(uint64_t));
+    }
+
+    if (!buffer_.empty())
+      std::fwrite(&buffer_[0], 1, buffer_.size(), file_);
+    std::fflush(file_);
+  }
+
+  struct flusher_function
+  {
+    tracking_state* state_;
+
+    void operator()()
+    {
+      mutex::scoped_lock lock(state_->mutex_);
+      while (!state_->stopping_)
+      {
+        if (!state_->flush_requested_.load())
+          state_->wakeup_.wait_for_usec(lock,
+              NET_TS_HANDLER_TRACKING_FLUSH_USEC);
+        if (!state_->stopping_)
+          state_->wakeup_.clear(lock);
+
+        state_->flush_requested_.store(false);
+        state_->flushing_.store(true);
+        state_->flush(lock);
+        state_->flushing_.store(false);
+      }
+    }
+  };
+
+  std::atomic<uint64_t> next_id_;
+  tss_ptr<completion> current_completion_;
+
+  // Set when a ring has filled to half its capacity since the last flush.
+  std::atomic<bool> flush_requested_;
+
+  // Set while the flushing thread is writing out events.
+  std::atomic<bool> flushing_;
+
+  // Protects the list of rings, the file, and the flusher's state.
+  mutex mutex_;
+  event wakeup_;
+  uint32_t next_thread_;
+  handler_tracking_ring* rings_;
+  bool stopping_;
+  std::FILE* file_;
+  std::set<uint64_t> strings_;
+  std::vector<handler_tracking_event> events_;
+  std::vector<std::pair<uint32_t, uint64_t> > dropped_;
+  std::vector<char> buffer_;
+  scoped_ptr<thread> flusher_;
+};
+
+handler_tracking::tracking_state* handler_tracking::get_state()
+{
+  static tracking_state state;
+  return &state;
+}
+
+inline uint64_t handler_tracking_key(const void* p)
+{
+  return static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(p));
+}
+
+inline handler_tracking_event make_handler_tracking_event(
+    char kind, uint64_t id)
+{
+  handler_tracking_event e;
+  std::memset(&e, 0, sizeof(e));
+  e.kind = static_cast<uint16_t>(kind);
+  e.id = id;
+  return e;
+}
+
+inline void set_handler_tracking_error(
+    handler_tracking_event& e, const std::error_code& ec)
+{
+  e.flags |= handler_tracking_event::has_error;
+  e.category = handler_tracking_key(&ec.category());
+  e.error = ec.value();
+}
+
+void handler_tracking::init()
+{
+  get_state();
+}
+
+void handler_tracking::creation(execution_context&,
+    handler_tracking::tracked_handler& h,
+    const char* object_type, void* object,
+    uintmax_t /*native_handle*/, const char* op_name)
+{
+  static tracking_state* state = get_state();
+
+  h.id_ = state->next_id_.fetch_add(1, std::memory_order_relaxed);
+
+  handler_tracking_event e = make_handler_tracking_event('*', h.id_);
+  if (completion* current_completion = state->current_completion_)
+    e.parent_id = current_completion->id_;
+  e.object = handler_tracking_key(object);
+  e.object_type = handler_tracking_key(object_type);
+  e.op_name = handler_tracking_key(op_name);
+  state->record(e);
+}
+
+handler_tracking::completion::completion(
+    const handler_tracking::tracked_handler& h)
+  : id_(h.id_),
+    invoked_(false),
+    next_(get_state()->current_completion_)
+{
+  get_state()->current_completion_ = this;
+}
+
+handler_tracking::completion::~completion()
+{
+  if (id_)
+  {
+    handler_tracking_event e = make_handler_tracking_event(
+        invoked_ ? '!' : '~', id_);
+    get_state()->record(e);
+  }
+
+  get_state()->current_completion_ = next_;
+}
+
+void handler_tracking::completion::invocation_begin()
+{
+  handler_tracking_event e = make_handler_tracking_event('>', id_);
+  get_state()->record(e);
+
+  invoked_ = true;
+}
+
+void handler_tracking::completion::invocation_begin(
+    const std::error_code& ec)
+{
+  handler_tracking_event e = make_handler_tracking_event('>', id_);
+  set_handler_tracking_error(e, ec);
+  get_state()->record(e);
+
+  invoked_ = true;
+}
+
+void handler_tracking::completion::invocation_begin(
+    const std::error_code& ec, std::size_t bytes_transferred)
+{
+  handler_tracking_event e = make_handler_tracking_event('>', id_);
+  set_handler_tracking_error(e, ec);
+  e.flags |= handler_tracking_event::has_argument;
+  e.argument = static_cast<uint64_t>(bytes_transferred);
+  get_state()->record(e);
+
+  invoked_ = true;
+}
+
+void handler_tracking::completion::invocation_begin(
+    const std::error_code& ec, int signal_number)
+{
+  handler_tracking_event e = make_handler_tracking_event('>', id_);
+  set_handler_tracking_error(e, ec);
+  e.flags |= handler_tracking_event::has_argument;
+  e.argument = static_cast<uint64_t>(signal_number);
+  get_state()->record(e);
+
+  invoked_ = true;
+}
+
+void handler_tracking::completion::invocation_begin(
+    const std::error_code& ec, const char* /*arg*/)
+{
+  // The argument is not a string literal, so only the error is recorded.
+  handler_tracking_event e = make_handler_tracking_event('>', id_);
+  set_handler_tracking_error(e, ec);
+  get_state()->record(e);
+
+  invoked_ = true;
+}
+
+void handler_tracking::completion::invocation_end()
+{
+  if (id_)
+  {
+    handler_tracking_event e = make_handler_tracking_event('<', id_);
+    get_state()->record(e);
+
+    id_ = 0;
+  }
+}
+
+void handler_tracking::operation(execution_context&,
+    const char* object_type, void* object,
+    uintmax_t /*native_handle*/, const char* op_name)
+{
+  static tracking_state* state = get_state();
+
+  handler_tracking_event e = make_handler_tracking_event('.', 0);
+  if (completion* current_completion = state->current_completion_)
+    e.parent_id = current_completion->id_;
+  e.object = handler_tracking_key(object);
+  e.object_type = handler_tracking_key(object_type);
+  e.op_name = handler_tracking_key(op_name);
+  state->record(e);
+}
+
+void handler_tracking::reactor_registration(execution_context& /*context*/,
+    uintmax_t /*native_handle*/, uintmax_t /*registration*/)
+{
+}
+
+void handler_tracking::reactor_deregistration(execution_context& /*context*/,
+    uintmax_t /*native_handle*/, uintmax_t /*registration*/)
+{
+}
+
+void handler_tracking::reactor_events(execution_context& /*context*/,
+    uintmax_t /*native_handle*/, unsigned /*events*/)
+{
+}
+
+void handler_tracking::reactor_operation(
+    const tracked_handler& h, const char* op_name,
+    const std::error_code& ec)
+{
+  handler_tracking_event e = make_handler_tracking_event('r', h.id_);
+  e.op_name = handler_tracking_key(op_name);
+  set_handler_tracking_error(e, ec);
+  get_state()->record(e);
+}
+
+void handler_tracking::reactor_operation(
+    const tracked_handler& h, const char* op_name,
+    const std::error_code& ec, std::size_t bytes_transferred)
+{
+  handler_tracking_event e = make_handler_tracking_event('r', h.id_);
+  e.op_name = handler_tracking_key(op_name);
+  set_handler_tracking_error(e, ec);
+  e.flags |= handler_tracking_event::has_argument;
+  e.argument = static_cast<uint64_t>(bytes_transferred);
+  get_state()->record(e);
+}
+
+void handler_tracking::write_line(const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  std::vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+void handler_tracking::flush()
+{
+  static tracking_state* state = get_state();
+
+  mutex::scoped_lock lock(state->mutex_);
+  state->flush(lock);
+}
+
+struct handler_tracking_event_before
+{
+  bool operator()(const handler_tracking_event& a,
+      const handler_tracking_event& b) const
+  {
+    return a.timestamp < b.timestamp;
+  }
+};
+
+inline void write_handler_tracking_json_string(std::ostream& out,
+    const std::string& s)
+{
+  static const char hex[] = "0123456789abcdef";
+  out << '"';
+  for (std::size_t i = 0; i < s.size(); ++i)
+  {
+    unsigned char c = static_cast<unsigned char>(s[i]);
+    if (c == '"' || c == '\\')
+      out << '\\' << s[i];
+    else if (c < 0x20)
+      out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+    else
+      out << s[i];
+  }
+  out << '"';
+}
+
+inline void write_handler_tracking_json_prefix(std::ostream& out, bool& first,
+    const char* ph, uint64_t ns, uint32_t thread)
+{
+  char ts[32];
+  std::sprintf(ts, "%llu.%03u",
+      static_cast<unsigned long long>(ns / 1000),
+      static_cast<unsigned>(ns % 1000));
+  out << (first ? "\n" : ",\n") << "{\"ph\":\"" << ph << "\",\"ts\":"
+    << ts << ",\"pid\":1,\"tid\":" << thread;
+  first = false;
+}
+
+bool handler_tracking::export_chrome_trace(
+    std::istream& in, std::ostream& out)
+{
+  char magic[sizeof(handler_tracking_magic)];
+  uint32_t event_size = 0;
+  if (!in.read(magic, sizeof(magic))
+      || std::memcmp(magic, handler_tracking_magic, sizeof(magic)) != 0
+      || !in.read(reinterpret_cast<char*>(&event_size), sizeof(event_size))
+      || event_size != sizeof(handler_tracking_event))
+    return false;
+
+  // Read all records.
+  std::map<uint64_t, std::string> strings;
+  std::vector<handler_tracking_event> events;
+  std::map<uint32_t, uint64_t> dropped;
+  char tag;
+  while (in.get(tag))
+  {
+    if (tag == handler_tracking_string_record)
+    {
+      uint64_t key = 0;
+      uint32_t length = 0;
+      in.read(reinterpret_cast<char*>(&key), sizeof(key));
+      in.read(reinterpret_cast<char*>(&length), sizeof(length));
+      std::string s(length, '\0');
+      if (length > 0)
+        in.read(&s[0], length);
+      strings[key] = s;
+    }
+    else if (tag == handler_tracking_event_record)
+    {
+      handler_tracking_event e;
+      in.read(reinterpret_cast<char*>(&e), sizeof(e));
+      events.push_back(e);
+    }
+    else if (tag == handler_tracking_dropped_record)
+    {
+      uint32_t thread = 0;
+      uint64_t count = 0;
+      in.read(reinterpret_cast<char*>(&thread), sizeof(thread));
+      in.read(reinterpret_cast<char*>(&count), sizeof(count));
+      dropped[thread] += count;
+    }
+    else
+    {
+      return false;
+    }
+
+    if (!in)
+      return false;
+  }
+
+  // The rings are written one after another, so the events must be merged.
+  std::stable_sort(events.begin(), events.end(),
+      handler_tracking_event_before());
+  uint64_t start = events.empty() ? 0 : events.front().timestamp;
+
+  std::map<uint64_t, std::string> names;
+  std::map<uint64_t, uint64_t> created;
+  std::set<uint32_t> threads;
+  bool first = true;
+
+  // The handlers currently being invoked on each thread, innermost last. When
+  // events have been dropped a handler's begin or end may be missing, so ends
+  // are matched against these, and any begin still open at the end of the
+  // trace is closed there.
+  std::map<uint32_t, std::vector<uint64_t> > invoking;
+  uint64_t end = 0;
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < events.size(); ++i)
+  {
+    const handler_tracking_event& e = events[i];
+    uint64_t ts = e.timestamp - start;
+    threads.insert(e.thread);
+    end = ts;
+
+    std::string error;
+    if (e.flags & handler_tracking_event::has_error)
+    {
+      char value[16];
+      std::sprintf(value, ":%d", static_cast<int>(e.error));
+      error = strings[e.category] + value;
+    }
+
+    switch (e.kind)
+    {
+    case '*':
+      {
+        std::string name = strings[e.object_type] + "." + strings[e.op_name];
+        names[e.id] = name;
+        created[e.id] = ts;
+        write_handler_tracking_json_prefix(out, first, "i", ts, e.thread);
+        out << ",\"s\":\"t\",\"cat\":\"creation\",\"name\":";
+        write_handler_tracking_json_string(out, name);
+        out << ",\"args\":{\"id\":" << e.id << ",\"parent\":" << e.parent_id
+          << ",\"object\":" << e.object << "}}";
+        write_handler_tracking_json_prefix(out, first, "s", ts, e.thread);
+        out << ",\"cat\":\"handler\",\"name\":\"handler\",\"id\":"
+          << e.id << "}";
+        break;
+      }
+    case '>':
+      {
+        write_handler_tracking_json_prefix(out, first, "B", ts, e.thread);
+        out << ",\"cat\":\"handler\",\"name\":";
+        write_handler_tracking_json_string(out,
+            names.count(e.id) ? names[e.id] : std::string("handler"));
+        out << ",\"args\":{\"id\":" << e.id;
+        if (created.count(e.id))
+          out << ",\"queued_ns\":" << (ts - created[e.id]);
+        if (e.flags & handler_tracking_event::has_error)
+        {
+          out << ",\"ec\":";
+          write_handler_tracking_json_string(out, error);
+        }
+        if (e.flags & handler_tracking_event::has_argument)
+          out << ",\"arg\":" << e.argument;
+        out << "}}";
+        write_handler_tracking_json_prefix(out, first, "f", ts, e.thread);
+        out << ",\"bp\":\"e\",\"cat\":\"handler\",\"name\":\"handler\",\"id\":"
+          << e.id << "}";
+        invoking[e.thread].push_back(e.id);
+        break;
+      }
+    case '<':
+    case '!':
+      {
+        // An end without a matching begin is left out. Any handlers invoked
+        // within this one whose ends were lost are closed along with it.
+        std::vector<uint64_t>& stack = invoking[e.thread];
+        if (std::find(stack.begin(), stack.end(), e.id) == stack.end())
+          break;
+        while (stack.back() != e.id)
+        {
+          write_handler_tracking_json_prefix(out, first, "E", ts, e.thread);
+          out << ",\"args\":{\"unmatched\":true}}";
+          stack.pop_back();
+        }
+        stack.pop_back();
+        write_handler_tracking_json_prefix(out, first, "E", ts, e.thread);
+        if (e.kind == '!')
+          out << ",\"args\":{\"exception\":true}";
+        out << "}";
+        names.erase(e.id);
+        created.erase(e.id);
+        break;
+      }
+    case '~':
+      write_handler_tracking_json_prefix(out, first, "i", ts, e.thread);
+      out << ",\"s\":\"t\",\"cat\":\"handler\",\"name\":\"destroyed\","
+        "\"args\":{\"id\":" << e.id << "}}";
+      names.erase(e.id);
+      created.erase(e.id);
+      break;
+    case '.':
+    case 'r':
+      {
+        std::string name = (e.kind == '.')
+          ? strings[e.object_type] + "." + strings[e.op_name]
+          : strings[e.op_name];
+        write_handler_tracking_json_prefix(out, first, "i", ts, e.thread);
+        out << ",\"s\":\"t\",\"cat\":\"operation\",\"name\":";
+        write_handler_tracking_json_string(out, name);
+        out << ",\"args\":{\"id\":" << (e.kind == '.' ? e.parent_id : e.id);
+        if (e.flags & handler_tracking_event::has_error)
+        {
+          out << ",\"ec\":";
+          write_handler_tracking_json_string(out, error);
+        }
+        if (e.flags & handler_tracking_event::has_argument)
+          out << ",\"bytes_transferred\":" << e.argument;
+        out << "}}";
+        break;
+      }
+    default:
+      break;
+    }
+  }
+
+  // Close the handlers that were still being invoked when the trace ended.
+  std::map<uint32_t, std::vector<uint64_t> >::iterator s = invoking.begin();
+  for (; s != invoking.end(); ++s)
+  {
+    for (std::size_t n = s->second.size(); n > 0; --n)
+    {
+      write_handler_tracking_json_prefix(out, first, "E", end, s->first);
+      out << ",\"args\":{\"unmatched\":true}}";
+    }
+  }
+
+  for (std::set<uint32_t>::iterator t = threads.begin();
+      t != threads.end(); ++t)
+  {
+    out << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << *t
+      << ",\"name\":\"thread_name\",\"args\":{\"name\":\"thread " << *t;
+    if (dropped.count(*t))
+      out << " (" << dropped[*t] << " events dropped)";
+    out << "\"}}";
+    first = false;
+  }
+
+  out << "\n]}\n";
+  return true;
+}
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+
+#endif // NET_TS_DETAIL_IMPL_BINARY_HANDLER_TRACKING_IPP
@@ -153,6 +153,14 @@ void dev_poll_reactor::start_op(int op_type, socket_type descriptor,
     dev_poll_reactor::per_descriptor_data&, reactor_op* op,
     bool is_continuation, bool allow_speculative)
 {
+  if (op->deadline_ != 0)
+  {
+    // Operation deadlines are only implemented by the epoll reactor.
+    op->ec_ = std::experimental::net::error::operation_not_supported;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
   std::experimental::net::detail::mutex::scoped_lock lock(mutex_);
 
   if (shutdown_)
@@ -237,7 +245,7 @@ void dev_poll_reactor::deregister_internal_descriptor(
     op_queue_[i].cancel_operations(descriptor, ops, ec);
 }
 
-void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
+std::size_t dev_poll_reactor::run(long usec, op_queue<operation>& ops)
 {
   std::experimental::net::detail::mutex::scoped_lock lock(mutex_);
 
@@ -245,7 +253,7 @@ void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
   // not supposed to block.
   if (!block && op_queue_[read_op].empty() && op_queue_[write_op].empty()
       && op_queue_[except_op].empty() && timer_queues_.all_empty())
-    return;
+    return 0;
 
   // Write the pending event registration changes to the /dev/poll descriptor.
   std::size_t events_size = sizeof(::pollfd) * pending_event_changes_.size();
@@ -291,6 +299,7 @@ void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
   lock.lock();
 
   // Dispatch the waiting events.
+  std::size_t n = 0;
   for (int i = 0; i < num_events; ++i)
   {
     int descriptor = events[i].fd;
@@ -300,6 +309,7 @@ void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
     }
     else
     {
+      ++n;
       bool more_reads = false;
       bool more_writes = false;
       bool more_except = false;
@@ -359,7 +369,9 @@ void dev_poll_reactor::run(long usec, op_queue<operation>& ops)
       }
     }
   }
-  timer_queues_.get_ready_timers(ops);
+  n += timer_queues_.get_ready_timers(ops);
+
+  return n;
 }
 
 void dev_poll_reactor::interrupt()
@@ -82,6 +82,20 @@ void epoll_reactor::move_timer(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void epoll_reactor::reschedule_timer(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& timer,
+    const typename Time_Traits::time_type& time)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+    return;
+
+  if (queue.reschedule_timer(timer, time))
+    update_timeout();
+}
+
 } // namespace detail
 } // inline namespace v1
 } // namespace net
@@ -20,10 +20,13 @@
 #if defined(NET_TS_HAS_EPOLL)
 
 #include <cstddef>
+#include <functional>
 #include <sys/epoll.h>
+#include <experimental/__net_ts/detail/concurrency_hint.hpp>
 #include <experimental/__net_ts/detail/epoll_reactor.hpp>
 #include <experimental/__net_ts/detail/throw_error.hpp>
 #include <experimental/__net_ts/error.hpp>
+#include <experimental/__net_ts/socket_base.hpp>
 
 #if defined(NET_TS_HAS_TIMERFD)
 # include <sys/timerfd.h>
@@ -45,6 +48,10 @@ epoll_reactor::epoll_reactor(std::experimental::net::execution_context& ctx)
     interrupter_(),
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
+    shard_count_(NET_TS_CONCURRENCY_HINT_REACTOR_SHARDS(
+          scheduler_.concurrency_hint())),
+    shards_(0),
+    next_shard_(0),
     shutdown_(false),
     registered_descriptors_mutex_(mutex_.enabled())
 {
@@ -62,10 +69,17 @@ epoll_reactor::epoll_reactor(std::experimental::net::execution_context& ctx)
     ev.data.ptr = &timer_fd_;
     epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
   }
+
+  create_shards();
+
+  // Add the queue used to expire operation deadlines.
+  timer_queues_.insert(&deadline_queue_);
 }
 
 epoll_reactor::~epoll_reactor()
 {
+  destroy_shards();
+  delete[] shards_;
   if (epoll_fd_ != -1)
     close(epoll_fd_);
   if (timer_fd_ != -1)
@@ -127,6 +141,9 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
+    destroy_shards();
+    create_shards();
+
     // Re-register all descriptors with epoll.
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
@@ -134,7 +151,8 @@ void epoll_reactor::notify_fork(
     {
       ev.events = state->registered_events_;
       ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
+      int result = epoll_ctl(shard_epoll_fd(state),
+          EPOLL_CTL_ADD, state->descriptor_, &ev);
       if (result != 0)
       {
         std::error_code ec(errno,
@@ -159,21 +177,26 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
         context(), static_cast<uintmax_t>(descriptor),
         reinterpret_cast<uintmax_t>(descriptor_data)));
 
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+
   {
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
+    descriptor_data->shard_ = (shard_count_ > 1)
+      ? static_cast<std::size_t>(++next_shard_) % shard_count_ : 0;
     descriptor_data->shutdown_ = false;
+    descriptor_data->registered_events_ = ev.events;
+    descriptor_data->deadline_ = 0;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
   }
 
-  epoll_event ev = { 0, { 0 } };
-  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
-  descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  int result = epoll_ctl(shard_epoll_fd(descriptor_data),
+      EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
   {
     if (errno == EPERM)
@@ -182,6 +205,7 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
       // a regular file then operations on it will not block. We will allow
       // this descriptor to be used and fail later if an operation on it would
       // otherwise require a trip through the reactor.
+      mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
       descriptor_data->registered_events_ = 0;
       return 0;
     }
@@ -201,20 +225,23 @@ int epoll_reactor::register_internal_descriptor(
         context(), static_cast<uintmax_t>(descriptor),
         reinterpret_cast<uintmax_t>(descriptor_data)));
 
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+
   {
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
+    descriptor_data->shard_ = 0;
     descriptor_data->shutdown_ = false;
+    descriptor_data->registered_events_ = ev.events;
+    descriptor_data->deadline_ = 0;
     descriptor_data->op_queue_[op_type].push(op);
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
   }
 
-  epoll_event ev = { 0, { 0 } };
-  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
-  descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
   int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
@@ -231,6 +258,72 @@ void epoll_reactor::move_descriptor(socket_type,
   source_descriptor_data = 0;
 }
 
+int epoll_reactor::set_registration_flags(socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data, int flags)
+{
+  if (!descriptor_data)
+    return EBADF;
+
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLET;
+  if (flags & socket_base::registration_exclusive)
+  {
+#if defined(EPOLLEXCLUSIVE)
+    // An exclusive registration cannot be modified, and may not include
+    // EPOLLPRI, so write readiness is requested up front.
+    ev.events |= EPOLLOUT | EPOLLEXCLUSIVE;
+#else // defined(EPOLLEXCLUSIVE)
+    return EOPNOTSUPP;
+#endif // defined(EPOLLEXCLUSIVE)
+  }
+  else
+  {
+    ev.events |= EPOLLPRI;
+    if (flags & socket_base::registration_one_shot)
+      ev.events |= EPOLLONESHOT;
+  }
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+    return EBADF;
+
+  // Descriptors that epoll does not support never wait for readiness.
+  if (descriptor_data->registered_events_ == 0)
+    return 0;
+
+  if ((ev.events & EPOLLOUT) == 0)
+    ev.events |= (descriptor_data->registered_events_ & EPOLLOUT);
+  ev.data.ptr = descriptor_data;
+
+  // EPOLLEXCLUSIVE may only be given when a descriptor is added, so the
+  // existing registration is replaced. Readiness is re-evaluated when the
+  // descriptor is added, and so no edge is lost.
+  int epoll_fd = shard_epoll_fd(descriptor_data);
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, descriptor, &ev);
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, descriptor, &ev) != 0)
+  {
+    int err = errno;
+    ev.events = descriptor_data->registered_events_;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, descriptor, &ev);
+    return err;
+  }
+
+  descriptor_data->registered_events_ = ev.events;
+  return 0;
+}
+
+bool epoll_reactor::is_exclusive_registration(
+    epoll_reactor::descriptor_state* descriptor_data)
+{
+#if defined(EPOLLEXCLUSIVE)
+  return (descriptor_data->registered_events_ & EPOLLEXCLUSIVE) != 0;
+#else // defined(EPOLLEXCLUSIVE)
+  (void)descriptor_data;
+  return false;
+#endif // defined(EPOLLEXCLUSIVE)
+}
+
 void epoll_reactor::start_op(int op_type, socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
     bool is_continuation, bool allow_speculative)
@@ -252,7 +345,11 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
 
   if (descriptor_data->op_queue_[op_type].empty())
   {
-    if (allow_speculative
+    // An exclusive registration cannot be modified to re-arm the descriptor,
+    // so the operation is always tried first. Any edge that arrives after
+    // that attempt will wake the reactor for it.
+    const bool is_exclusive = is_exclusive_registration(descriptor_data);
+    if ((allow_speculative || is_exclusive)
         && (op_type != read_op
           || descriptor_data->op_queue_[except_op].empty()))
     {
@@ -283,7 +380,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
           epoll_event ev = { 0, { 0 } };
           ev.events = descriptor_data->registered_events_ | EPOLLOUT;
           ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
+          if (epoll_ctl(shard_epoll_fd(descriptor_data),
+                EPOLL_CTL_MOD, descriptor, &ev) == 0)
           {
             descriptor_data->registered_events_ |= ev.events;
           }
@@ -310,15 +408,23 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
         descriptor_data->registered_events_ |= EPOLLOUT;
       }
 
-      epoll_event ev = { 0, { 0 } };
-      ev.events = descriptor_data->registered_events_;
-      ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+      // An exclusive registration already includes EPOLLOUT.
+      if (!is_exclusive)
+      {
+        epoll_event ev = { 0, { 0 } };
+        ev.events = descriptor_data->registered_events_;
+        ev.data.ptr = descriptor_data;
+        epoll_ctl(shard_epoll_fd(descriptor_data),
+            EPOLL_CTL_MOD, descriptor, &ev);
+      }
     }
   }
 
   descriptor_data->op_queue_[op_type].push(op);
   scheduler_.work_started();
+
+  if (op->deadline_ != 0)
+    arm_deadline(descriptor_data, op->deadline_);
 }
 
 void epoll_reactor::cancel_ops(socket_type,
@@ -363,7 +469,8 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
     else if (descriptor_data->registered_events_ != 0)
     {
       epoll_event ev = { 0, { 0 } };
-      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+      epoll_ctl(shard_epoll_fd(descriptor_data),
+          EPOLL_CTL_DEL, descriptor, &ev);
     }
 
     op_queue<operation> ops;
@@ -377,6 +484,11 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
       }
     }
 
+    // If the deadline timer has fired, its operation still refers to the
+    // descriptor state and so must be left to free it.
+    bool deadline_pending = descriptor_data->deadline_ != 0
+      && !disarm_deadline(descriptor_data);
+
     descriptor_data->descriptor_ = -1;
     descriptor_data->shutdown_ = true;
 
@@ -386,7 +498,8 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
           context(), static_cast<uintmax_t>(descriptor),
           reinterpret_cast<uintmax_t>(descriptor_data)));
 
-    free_descriptor_state(descriptor_data);
+    if (!deadline_pending)
+      free_descriptor_state(descriptor_data);
     descriptor_data = 0;
 
     scheduler_.post_deferred_completions(ops);
@@ -404,7 +517,8 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
   if (!descriptor_data->shutdown_)
   {
     epoll_event ev = { 0, { 0 } };
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+    epoll_ctl(shard_epoll_fd(descriptor_data),
+        EPOLL_CTL_DEL, descriptor, &ev);
 
     op_queue<operation> ops;
     for (int i = 0; i < max_ops; ++i)
@@ -424,7 +538,7 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
   }
 }
 
-void epoll_reactor::run(long usec, op_queue<operation>& ops)
+std::size_t epoll_reactor::run(long usec, op_queue<operation>& ops)
 {
   // This code relies on the fact that the scheduler queues the reactor task
   // behind all descriptor operations generated by this function. This means,
@@ -465,6 +579,11 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       // Ignore.
     }
 # endif // defined(NET_TS_HAS_TIMERFD)
+    else if (find_shard(ptr))
+    {
+      // Ignore.
+    }
+    else
     {
       unsigned event_mask = 0;
       if ((events[i].events & EPOLLIN) != 0)
@@ -486,6 +605,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 #endif // defined(NET_TS_HAS_TIMERFD)
 
   // Dispatch the waiting events.
+  std::size_t n = 0;
   for (int i = 0; i < num_events; ++i)
   {
     void* ptr = events[i].data.ptr;
@@ -509,6 +629,17 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       check_timers = true;
     }
 #endif // defined(NET_TS_HAS_TIMERFD)
+    else if (shard_state* shard = find_shard(ptr))
+    {
+      // The shard's events are collected when the shard's operation is run.
+      // The shard's registration is one-shot, so it will not be returned
+      // again until it has been drained and rearmed. The lock pairs with the
+      // one taken when rearming, to order this push after the shard's removal
+      // from the scheduler's queue.
+      mutex::scoped_lock lock(mutex_);
+      ops.push(shard);
+      ++n;
+    }
     else
     {
       // The descriptor operation doesn't count as work in and of itself, so we
@@ -517,13 +648,14 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
       descriptor_data->set_ready_events(events[i].events);
       ops.push(descriptor_data);
+      ++n;
     }
   }
 
   if (check_timers)
   {
     mutex::scoped_lock common_lock(mutex_);
-    timer_queues_.get_ready_timers(ops);
+    n += timer_queues_.get_ready_timers(ops);
 
 #if defined(NET_TS_HAS_TIMERFD)
     if (timer_fd_ != -1)
@@ -535,6 +667,8 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     }
 #endif // defined(NET_TS_HAS_TIMERFD)
   }
+
+  return n;
 }
 
 void epoll_reactor::interrupt()
@@ -594,6 +728,108 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(NET_TS_HAS_TIMERFD)
 }
 
+void epoll_reactor::create_shards()
+{
+  if (shard_count_ <= 1)
+    return;
+
+  if (!shards_)
+    shards_ = new shard_state[shard_count_ - 1];
+
+  for (std::size_t i = 0; i < shard_count_ - 1; ++i)
+  {
+#if defined(EPOLL_CLOEXEC)
+    int fd = epoll_create1(EPOLL_CLOEXEC);
+#else // defined(EPOLL_CLOEXEC)
+    int fd = epoll_create(epoll_size);
+    if (fd != -1)
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif // defined(EPOLL_CLOEXEC)
+
+    epoll_event ev = { 0, { 0 } };
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = &shards_[i];
+    if (fd != -1 && epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0)
+    {
+      ::close(fd);
+      fd = -1;
+    }
+
+    // If an epoll instance cannot be created, the descriptors that would
+    // have been assigned to this shard are given to the main epoll
+    // descriptor instead.
+    if (fd == -1)
+    {
+      shard_count_ = i + 1;
+      break;
+    }
+
+    shards_[i].reactor_ = this;
+    shards_[i].epoll_fd_ = fd;
+  }
+}
+
+void epoll_reactor::destroy_shards()
+{
+  for (std::size_t i = 0; shards_ && i < shard_count_ - 1; ++i)
+  {
+    if (shards_[i].epoll_fd_ != -1)
+      ::close(shards_[i].epoll_fd_);
+    shards_[i].epoll_fd_ = -1;
+  }
+}
+
+epoll_reactor::shard_state* epoll_reactor::find_shard(void* ptr) const
+{
+  if (shard_count_ <= 1)
+    return 0;
+
+  std::less<const void*> less;
+  shard_state* first = shards_;
+  shard_state* last = shards_ + (shard_count_ - 1);
+  if (less(ptr, first) || !less(ptr, last))
+    return 0;
+  return static_cast<shard_state*>(ptr);
+}
+
+void epoll_reactor::drain_shard(epoll_reactor::shard_state* shard)
+{
+  epoll_event events[128];
+  int num_events = epoll_wait(shard->epoll_fd_, events, 128, 0);
+
+  op_queue<operation> ops;
+  for (int i = 0; i < num_events; ++i)
+  {
+    void* ptr = events[i].data.ptr;
+    descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
+    descriptor_data->set_ready_events(events[i].events);
+    ops.push(descriptor_data);
+  }
+
+  if (num_events > 0)
+  {
+    // Queue the shard behind the descriptor operations, so that they will
+    // have been dequeued by the time the shard is drained again.
+    ops.push(shard);
+  }
+  else
+  {
+    // Rearm the shard's registration with the main epoll descriptor. The
+    // shard's descriptor is level-triggered, so any events that have arrived
+    // since the shard was drained will be reported immediately.
+    mutex::scoped_lock lock(mutex_);
+    epoll_event ev = { 0, { 0 } };
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = shard;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, shard->epoll_fd_, &ev);
+  }
+
+  // The shard operation doesn't count as work, so we need to compensate for
+  // the work_finished() call that the scheduler will make once it returns.
+  scheduler_.compensating_work_started();
+  scheduler_.post_deferred_completions(ops);
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
@@ -606,6 +842,104 @@ void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
   registered_descriptors_.free(s);
 }
 
+int64_t epoll_reactor::deadline_now()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void epoll_reactor::arm_deadline(
+    epoll_reactor::descriptor_state* s, int64_t deadline)
+{
+  if (s->deadline_ != 0 && s->deadline_ <= deadline)
+    return;
+
+  deadline_queue::time_type time(
+      chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::nanoseconds(deadline)));
+
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+    return;
+
+  // If the timer has already fired but its operation has not yet run, there
+  // is nothing to requeue. The operation re-arms the timer for the earliest
+  // deadline that remains.
+  bool earliest = (s->deadline_ == 0)
+    ? deadline_queue_.enqueue_timer(time, s->deadline_timer_, &s->deadline_op_)
+    : deadline_queue_.reschedule_timer(s->deadline_timer_, time);
+  s->deadline_ = deadline;
+  if (earliest)
+    update_timeout();
+}
+
+bool epoll_reactor::disarm_deadline(epoll_reactor::descriptor_state* s)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  // The cancelled operation is destroyed rather than run, since the
+  // descriptor no longer has any operations to expire.
+  op_queue<operation> ops;
+  if (deadline_queue_.cancel_timer(s->deadline_timer_, ops) == 0)
+    return false;
+
+  s->deadline_ = 0;
+  return true;
+}
+
+void epoll_reactor::expire_deadlines(epoll_reactor::descriptor_state* s)
+{
+  // The deadline operation doesn't count as work, so we need to compensate
+  // for the work_finished() call that the scheduler will make once it
+  // returns.
+  scheduler_.compensating_work_started();
+
+  mutex::scoped_lock descriptor_lock(s->mutex_);
+
+  s->deadline_ = 0;
+
+  // The descriptor was deregistered while this operation was pending, and
+  // its state was left for this operation to free.
+  if (s->shutdown_)
+  {
+    descriptor_lock.unlock();
+    free_descriptor_state(s);
+    return;
+  }
+
+  const int64_t now = deadline_now();
+  int64_t next = 0;
+  op_queue<operation> ops;
+  for (int i = 0; i < max_ops; ++i)
+  {
+    op_queue<reactor_op> remaining;
+    while (reactor_op* op = s->op_queue_[i].front())
+    {
+      s->op_queue_[i].pop();
+      if (op->deadline_ != 0 && op->deadline_ <= now)
+      {
+        op->ec_ = std::experimental::net::error::timed_out;
+        ops.push(op);
+      }
+      else
+      {
+        if (op->deadline_ != 0 && (next == 0 || op->deadline_ < next))
+          next = op->deadline_;
+        remaining.push(op);
+      }
+    }
+    s->op_queue_[i].push(remaining);
+  }
+
+  if (next != 0)
+    arm_deadline(s, next);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -691,7 +1025,9 @@ struct epoll_reactor::perform_io_cleanup_on_block_exit
 
 epoll_reactor::descriptor_state::descriptor_state(bool locking)
   : operation(&epoll_reactor::descriptor_state::do_complete),
-    mutex_(locking)
+    mutex_(locking),
+    deadline_op_(this),
+    deadline_(0)
 {
 }
 
@@ -727,6 +1063,17 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
     }
   }
 
+  // A one-shot registration is disarmed by each event, so it is re-armed now
+  // that the events have been processed.
+  if ((registered_events_ & EPOLLONESHOT) && !shutdown_)
+  {
+    epoll_event ev = { 0, { 0 } };
+    ev.events = registered_events_;
+    ev.data.ptr = this;
+    epoll_ctl(reactor_->shard_epoll_fd(this),
+        EPOLL_CTL_MOD, descriptor_, &ev);
+  }
+
   // The first operation will be returned for completion now. The others will
   // be posted for later by the io_cleanup object's destructor.
   io_cleanup.first_op_ = io_cleanup.ops_.front();
@@ -734,6 +1081,35 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   return io_cleanup.first_op_;
 }
 
+epoll_reactor::shard_state::shard_state()
+  : operation(&epoll_reactor::shard_state::do_complete),
+    reactor_(0),
+    epoll_fd_(-1)
+{
+}
+
+void epoll_reactor::shard_state::do_complete(
+    void* owner, operation* base,
+    const std::error_code& /*ec*/, std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    shard_state* shard = static_cast<shard_state*>(base);
+    shard->reactor_->drain_shard(shard);
+  }
+}
+
+void epoll_reactor::descriptor_state::deadline_op::do_complete(
+    void* owner, operation* base,
+    const std::error_code& /*ec*/, std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    descriptor_state* state = static_cast<deadline_op*>(base)->state_;
+    state->reactor_->expire_deadlines(state);
+  }
+}
+
 void epoll_reactor::descriptor_state::do_complete(
     void* owner, operation* base,
     const std::error_code& ec, std::size_t bytes_transferred)
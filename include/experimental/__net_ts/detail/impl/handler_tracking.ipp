@@ -21,6 +21,10 @@
 
 // The handler tracking implementation is provided by the user-specified header.
 
+#elif defined(NET_TS_HAS_BINARY_HANDLER_TRACKING)
+
+# include <experimental/__net_ts/detail/impl/binary_handler_tracking.ipp>
+
 #elif defined(NET_TS_ENABLE_HANDLER_TRACKING)
 
 #include <cstdarg>
@@ -0,0 +1,968 @@
+//
+// detail/impl/io_uring_reactor.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_IMPL_IO_URING_REACTOR_IPP
+#define NET_TS_DETAIL_IMPL_IO_URING_REACTOR_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_IO_URING)
+
+#include <cstddef>
+#include <cstring>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <experimental/__net_ts/detail/io_uring_reactor.hpp>
+#include <experimental/__net_ts/detail/scheduler.hpp>
+#include <experimental/__net_ts/detail/throw_error.hpp>
+#include <experimental/__net_ts/error.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+io_uring_reactor::io_uring_reactor(
+    std::experimental::net::execution_context& ctx)
+  : execution_context_service_base<io_uring_reactor>(ctx),
+    scheduler_(use_service<scheduler>(ctx)),
+    mutex_(NET_TS_CONCURRENCY_HINT_IS_LOCKING(
+          SCHEDULER, scheduler_.concurrency_hint())),
+    ring_fd_(-1),
+    ring_(0),
+    ring_bytes_(0),
+    sqes_(0),
+    sqes_bytes_(0),
+    sq_head_(0),
+    sq_tail_(0),
+    sq_mask_(0),
+    sq_entries_(0),
+    cq_head_(0),
+    cq_tail_(0),
+    cq_mask_(0),
+    cqes_(0),
+    outstanding_(0),
+    waiting_(false),
+    interrupted_(false),
+    timeout_pending_(false),
+    shutdown_(false),
+    registered_descriptors_mutex_(mutex_.enabled())
+{
+  timeout_.tv_sec = 0;
+  timeout_.tv_nsec = 0;
+
+  do_ring_create();
+
+  // Arm the timeout used to wake the reactor for timers.
+  mutex::scoped_lock lock(mutex_);
+  update_timeout();
+}
+
+io_uring_reactor::~io_uring_reactor()
+{
+  do_ring_destroy();
+}
+
+void io_uring_reactor::shutdown()
+{
+  mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  lock.unlock();
+
+  // Operations that are in flight may refer to memory owned by the operation
+  // objects, so they must be cancelled and their completions harvested before
+  // the objects can be destroyed.
+  for (descriptor_state* state = registered_descriptors_.first();
+      state != 0; state = state->next_)
+  {
+    for (int i = 0; i < max_ops; ++i)
+      if (state->queues_[i].in_flight_)
+        submit_cancel(state->queues_[i]);
+  }
+
+  lock.lock();
+  flush_sqes();
+  while (outstanding_ > 0)
+  {
+    if (*cq_head_ == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+      do_enter(0, 1, -1);
+    bool check_timers = false;
+    outstanding_ -= reap_cqes(0, check_timers);
+  }
+  lock.unlock();
+
+  op_queue<operation> ops;
+
+  while (descriptor_state* state = registered_descriptors_.first())
+  {
+    for (int i = 0; i < max_ops; ++i)
+      ops.push(state->queues_[i].op_queue_);
+    state->shutdown_ = true;
+    registered_descriptors_.free(state);
+  }
+
+  timer_queues_.get_all_timers(ops);
+
+  scheduler_.abandon_operations(ops);
+}
+
+void io_uring_reactor::notify_fork(
+    std::experimental::net::execution_context::fork_event fork_ev)
+{
+  if (fork_ev == std::experimental::net::execution_context::fork_child)
+  {
+    // The rings are shared with the parent process, so the child must not
+    // touch them. Create a new instance instead.
+    do_ring_destroy();
+    do_ring_create();
+
+    mutex::scoped_lock lock(mutex_);
+    outstanding_ = 0;
+    waiting_ = false;
+    timeout_pending_ = false;
+    update_timeout();
+    lock.unlock();
+
+    // Resubmit the operations that were in flight in the parent's instance.
+    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+    for (descriptor_state* state = registered_descriptors_.first();
+        state != 0; state = state->next_)
+    {
+      mutex::scoped_lock descriptor_lock(state->mutex_);
+      for (int i = 0; i < max_ops; ++i)
+      {
+        io_queue& q = state->queues_[i];
+        if (q.in_flight_)
+        {
+          q.in_flight_ = false;
+          q.cancel_requested_ = false;
+          ::io_uring_sqe sqe;
+          prepare_io(q, sqe);
+          int result = submit_io(q, sqe);
+          if (result != 0)
+          {
+            std::error_code ec(result,
+                std::experimental::net::error::get_system_category());
+            std::experimental::net::detail::throw_error(
+                ec, "io_uring re-submission");
+          }
+        }
+      }
+    }
+  }
+}
+
+void io_uring_reactor::init_task()
+{
+  scheduler_.init_task();
+}
+
+int io_uring_reactor::register_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  descriptor_data = allocate_descriptor_state();
+
+  NET_TS_HANDLER_REACTOR_REGISTRATION((
+        context(), static_cast<uintmax_t>(descriptor),
+        reinterpret_cast<uintmax_t>(descriptor_data)));
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->reactor_ = this;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+
+  return 0;
+}
+
+int io_uring_reactor::register_internal_descriptor(
+    int op_type, socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data, reactor_op* op)
+{
+  descriptor_data = allocate_descriptor_state();
+
+  NET_TS_HANDLER_REACTOR_REGISTRATION((
+        context(), static_cast<uintmax_t>(descriptor),
+        reinterpret_cast<uintmax_t>(descriptor_data)));
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->reactor_ = this;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+
+  io_queue& q = descriptor_data->queues_[op_type];
+  q.op_queue_.push(op);
+  ::io_uring_sqe sqe;
+  prepare_io(q, sqe);
+  return submit_io(q, sqe);
+}
+
+void io_uring_reactor::move_descriptor(socket_type,
+    io_uring_reactor::per_descriptor_data& target_descriptor_data,
+    io_uring_reactor::per_descriptor_data& source_descriptor_data)
+{
+  target_descriptor_data = source_descriptor_data;
+  source_descriptor_data = 0;
+}
+
+void io_uring_reactor::start_op(int op_type, socket_type,
+    io_uring_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
+    bool is_continuation, bool allow_speculative)
+{
+  if (op->deadline_ != 0)
+  {
+    // Operation deadlines are only implemented by the epoll reactor.
+    op->ec_ = std::experimental::net::error::operation_not_supported;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  if (!descriptor_data)
+  {
+    op->ec_ = std::experimental::net::error::bad_descriptor;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  io_queue& q = descriptor_data->queues_[op_type];
+  bool first = q.op_queue_.empty();
+  q.op_queue_.push(op);
+
+  if (first)
+  {
+    ::io_uring_sqe sqe;
+    prepare_io(q, sqe);
+
+    // Operations that can be submitted directly are left entirely to the
+    // kernel. Only those that wait for readiness are worth attempting now.
+    if (q.polling_ && allow_speculative
+        && (op_type != read_op
+          || descriptor_data->queues_[except_op].op_queue_.empty()))
+    {
+      if (op->perform())
+      {
+        q.op_queue_.pop();
+        descriptor_lock.unlock();
+        scheduler_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+    }
+
+    if (int result = submit_io(q, sqe))
+    {
+      q.op_queue_.pop();
+      op->ec_ = std::error_code(result,
+          std::experimental::net::error::get_system_category());
+      descriptor_lock.unlock();
+      scheduler_.post_immediate_completion(op, is_continuation);
+      return;
+    }
+  }
+
+  scheduler_.work_started();
+}
+
+void io_uring_reactor::cancel_ops(socket_type,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  for (int i = 0; i < max_ops; ++i)
+  {
+    io_queue& q = descriptor_data->queues_[i];
+
+    // The in-flight operation is owned by the kernel until its completion is
+    // delivered, so it can only be asked to finish early.
+    reactor_op* in_flight_op = 0;
+    if (q.in_flight_)
+    {
+      in_flight_op = q.op_queue_.front();
+      q.op_queue_.pop();
+    }
+
+    while (reactor_op* op = q.op_queue_.front())
+    {
+      op->ec_ = std::experimental::net::error::operation_aborted;
+      q.op_queue_.pop();
+      ops.push(op);
+    }
+
+    if (in_flight_op)
+    {
+      q.op_queue_.push(in_flight_op);
+      submit_cancel(q);
+    }
+  }
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+void io_uring_reactor::deregister_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data, bool)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    // Any in-flight operations are cancelled rather than aborted here. The
+    // cancellation is submitted before returning so that the kernel has
+    // already taken its own reference to the descriptor when it is closed.
+    op_queue<operation> ops;
+    bool in_flight = false;
+    for (int i = 0; i < max_ops; ++i)
+    {
+      io_queue& q = descriptor_data->queues_[i];
+
+      reactor_op* in_flight_op = 0;
+      if (q.in_flight_)
+      {
+        in_flight_op = q.op_queue_.front();
+        q.op_queue_.pop();
+      }
+
+      while (reactor_op* op = q.op_queue_.front())
+      {
+        op->ec_ = std::experimental::net::error::operation_aborted;
+        q.op_queue_.pop();
+        ops.push(op);
+      }
+
+      if (in_flight_op || q.in_flight_)
+      {
+        if (in_flight_op)
+          q.op_queue_.push(in_flight_op);
+        submit_cancel(q);
+        in_flight = true;
+      }
+    }
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->shutdown_ = true;
+
+    descriptor_lock.unlock();
+
+    (void)descriptor;
+    NET_TS_HANDLER_REACTOR_DEREGISTRATION((
+          context(), static_cast<uintmax_t>(descriptor),
+          reinterpret_cast<uintmax_t>(descriptor_data)));
+
+    // If operations are still in flight, the descriptor state is freed once
+    // the last of their completions has been delivered.
+    if (!in_flight)
+      free_descriptor_state(descriptor_data);
+    descriptor_data = 0;
+
+    scheduler_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_reactor::deregister_internal_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    // Internal operations only ever wait for readiness, so they own no memory
+    // that the kernel may still write to and can be destroyed immediately.
+    op_queue<operation> ops;
+    bool in_flight = false;
+    for (int i = 0; i < max_ops; ++i)
+    {
+      io_queue& q = descriptor_data->queues_[i];
+      ops.push(q.op_queue_);
+      if (q.in_flight_)
+      {
+        submit_cancel(q);
+        in_flight = true;
+      }
+    }
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->shutdown_ = true;
+
+    descriptor_lock.unlock();
+
+    (void)descriptor;
+    NET_TS_HANDLER_REACTOR_DEREGISTRATION((
+          context(), static_cast<uintmax_t>(descriptor),
+          reinterpret_cast<uintmax_t>(descriptor_data)));
+
+    if (!in_flight)
+      free_descriptor_state(descriptor_data);
+    descriptor_data = 0;
+  }
+}
+
+std::size_t io_uring_reactor::run(long usec, op_queue<operation>& ops)
+{
+  // This code relies on the fact that the scheduler queues the reactor task
+  // behind all descriptor operations generated by this function. This means,
+  // that by the time we reach this point, any previously returned io_queue
+  // operations have already been dequeued. Since a queue never has more than
+  // one entry in flight, it is safe for us to return it again.
+
+  // Entries queued by other threads are submitted here, in a single call that
+  // is also used to wait for completions.
+  mutex::scoped_lock lock(mutex_);
+  unsigned to_submit = *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  unsigned wait_nr = 0;
+  if (usec != 0 && !interrupted_
+      && *cq_head_ == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+  {
+    wait_nr = 1;
+    waiting_ = true;
+  }
+  interrupted_ = false;
+  lock.unlock();
+
+  if (to_submit > 0 || wait_nr > 0)
+    do_enter(to_submit, wait_nr, usec);
+
+  if (wait_nr > 0)
+  {
+    lock.lock();
+    waiting_ = false;
+    lock.unlock();
+  }
+
+  // Dispatch the completed operations. The io_queue operation doesn't count
+  // as work in and of itself, so we don't call work_started() here. This
+  // still allows the scheduler to stop if the only remaining operations are
+  // descriptor operations.
+  bool check_timers = false;
+  std::size_t n = reap_cqes(&ops, check_timers);
+  std::size_t events = n;
+
+  if (n > 0 || check_timers)
+  {
+    lock.lock();
+    outstanding_ -= n;
+    if (check_timers)
+    {
+      timeout_pending_ = false;
+      events += timer_queues_.get_ready_timers(ops);
+      update_timeout();
+    }
+  }
+
+  return events;
+}
+
+void io_uring_reactor::interrupt()
+{
+  mutex::scoped_lock lock(mutex_);
+  if (waiting_)
+  {
+    // Any completion will wake the waiting thread.
+    ::io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_NOP;
+    push_sqe(sqe);
+  }
+  else
+  {
+    interrupted_ = true;
+  }
+}
+
+void io_uring_reactor::do_ring_create()
+{
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  int fd = static_cast<int>(::syscall(__NR_io_uring_setup,
+        static_cast<unsigned>(ring_size), &params));
+  if (fd < 0)
+  {
+    std::error_code ec(errno,
+        std::experimental::net::error::get_system_category());
+    std::experimental::net::detail::throw_error(ec, "io_uring_setup");
+  }
+
+  // Extended wait arguments and timeout updates first appeared together,
+  // in Linux 5.11.
+  const unsigned required_features = IORING_FEAT_SINGLE_MMAP
+    | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+  if ((params.features & required_features) != required_features)
+  {
+    ::close(fd);
+    std::error_code ec = std::experimental::net::error::operation_not_supported;
+    std::experimental::net::detail::throw_error(ec, "io_uring_setup");
+  }
+
+  std::size_t sq_bytes = params.sq_off.array
+    + params.sq_entries * sizeof(unsigned);
+  std::size_t cq_bytes = params.cq_off.cqes
+    + params.cq_entries * sizeof(::io_uring_cqe);
+  std::size_t ring_bytes = sq_bytes > cq_bytes ? sq_bytes : cq_bytes;
+  void* ring = ::mmap(0, ring_bytes, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring == MAP_FAILED)
+  {
+    std::error_code ec(errno,
+        std::experimental::net::error::get_system_category());
+    ::close(fd);
+    std::experimental::net::detail::throw_error(ec, "io_uring mmap");
+  }
+
+  std::size_t sqes_bytes = params.sq_entries * sizeof(::io_uring_sqe);
+  void* sqes = ::mmap(0, sqes_bytes, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+  {
+    std::error_code ec(errno,
+        std::experimental::net::error::get_system_category());
+    ::munmap(ring, ring_bytes);
+    ::close(fd);
+    std::experimental::net::detail::throw_error(ec, "io_uring mmap");
+  }
+
+  char* base = static_cast<char*>(ring);
+  ring_fd_ = fd;
+  ring_ = ring;
+  ring_bytes_ = ring_bytes;
+  sqes_ = static_cast< ::io_uring_sqe*>(sqes);
+  sqes_bytes_ = sqes_bytes;
+  sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast< ::io_uring_cqe*>(base + params.cq_off.cqes);
+
+  // Entries are always used in ring order, so the indirection array is set
+  // up once as an identity mapping.
+  unsigned* sq_array = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+  for (unsigned i = 0; i < sq_entries_; ++i)
+    sq_array[i] = i;
+}
+
+void io_uring_reactor::do_ring_destroy()
+{
+  if (sqes_)
+    ::munmap(sqes_, sqes_bytes_);
+  sqes_ = 0;
+  if (ring_)
+    ::munmap(ring_, ring_bytes_);
+  ring_ = 0;
+  if (ring_fd_ != -1)
+    ::close(ring_fd_);
+  ring_fd_ = -1;
+}
+
+io_uring_reactor::descriptor_state*
+io_uring_reactor::allocate_descriptor_state()
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  return registered_descriptors_.alloc(registered_descriptors_mutex_.enabled());
+}
+
+void io_uring_reactor::free_descriptor_state(
+    io_uring_reactor::descriptor_state* s)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  registered_descriptors_.free(s);
+}
+
+void io_uring_reactor::do_add_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.insert(&queue);
+}
+
+void io_uring_reactor::do_remove_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.erase(&queue);
+}
+
+void io_uring_reactor::update_timeout()
+{
+  // By default we will wait no longer than 5 minutes. This will ensure that
+  // any changes to the system clock are detected after no longer than this.
+  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+  timeout_.tv_sec = usec / 1000000;
+  timeout_.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
+
+  // The kernel reads the timeout value when the entry is submitted, so a
+  // single timespec serves both new and updated timeouts.
+  ::io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  if (timeout_pending_)
+  {
+    sqe.opcode = IORING_OP_TIMEOUT_REMOVE;
+    sqe.addr = reinterpret_cast<uintptr_t>(&timeout_);
+    sqe.addr2 = reinterpret_cast<uintptr_t>(&timeout_);
+    sqe.timeout_flags = IORING_TIMEOUT_UPDATE;
+  }
+  else
+  {
+    sqe.opcode = IORING_OP_TIMEOUT;
+    sqe.addr = reinterpret_cast<uintptr_t>(&timeout_);
+    sqe.len = 1;
+    sqe.user_data = reinterpret_cast<uintptr_t>(&timeout_);
+    timeout_pending_ = (push_sqe(sqe) == 0);
+    return;
+  }
+  push_sqe(sqe);
+}
+
+void io_uring_reactor::prepare_io(io_queue& q, ::io_uring_sqe& sqe)
+{
+  std::memset(&sqe, 0, sizeof(sqe));
+  if (q.op_queue_.front()->prepare(sqe))
+  {
+    q.polling_ = false;
+    sqe.user_data = reinterpret_cast<uintptr_t>(&q);
+  }
+  else
+  {
+    prepare_poll(q, sqe);
+  }
+}
+
+void io_uring_reactor::prepare_poll(io_queue& q, ::io_uring_sqe& sqe)
+{
+  // Exception operations wait for out-of-band data.
+  static const unsigned flag[max_ops] = { POLLIN, POLLOUT, POLLPRI };
+  unsigned events = flag[q.op_type_];
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  events = (events << 16) | (events >> 16);
+#endif // defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_POLL_ADD;
+  sqe.fd = q.descriptor_data_->descriptor_;
+  sqe.poll32_events = events;
+  sqe.user_data = reinterpret_cast<uintptr_t>(&q);
+  q.polling_ = true;
+}
+
+int io_uring_reactor::submit_io(io_queue& q, ::io_uring_sqe& sqe)
+{
+  mutex::scoped_lock lock(mutex_);
+  int result = push_sqe(sqe);
+  if (result == 0)
+  {
+    q.in_flight_ = true;
+    ++outstanding_;
+  }
+  return result;
+}
+
+void io_uring_reactor::submit_cancel(io_queue& q)
+{
+  q.cancel_requested_ = true;
+
+  ::io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_ASYNC_CANCEL;
+  sqe.addr = reinterpret_cast<uintptr_t>(&q);
+
+  // Cancellation is submitted immediately, while the descriptor's mutex is
+  // still held, so that it cannot apply to any later operation.
+  mutex::scoped_lock lock(mutex_);
+  if (push_sqe(sqe) == 0)
+    flush_sqes();
+}
+
+int io_uring_reactor::push_sqe(const ::io_uring_sqe& sqe)
+{
+  for (;;)
+  {
+    unsigned tail = *sq_tail_;
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) < sq_entries_)
+    {
+      sqes_[tail & sq_mask_] = sqe;
+      __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      break;
+    }
+
+    // The submission queue is full.
+    if (int result = flush_sqes())
+      return result;
+  }
+
+  // A blocked thread will not submit new entries until it wakes up.
+  if (waiting_)
+    flush_sqes();
+
+  return 0;
+}
+
+int io_uring_reactor::flush_sqes()
+{
+  for (;;)
+  {
+    unsigned to_submit = *sq_tail_
+      - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (to_submit == 0)
+      return 0;
+
+    int result = do_enter(to_submit, 0, 0);
+    if (result < 0)
+    {
+      if (errno != EINTR)
+        return errno;
+    }
+    else if (result == 0)
+    {
+      return 0;
+    }
+  }
+}
+
+int io_uring_reactor::do_enter(unsigned to_submit, unsigned wait_nr, long usec)
+{
+  unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+  if (wait_nr > 0 && usec >= 0)
+  {
+    __kernel_timespec ts;
+    ts.tv_sec = usec / 1000000;
+    ts.tv_nsec = (usec % 1000000) * 1000;
+
+    ::io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uintptr_t>(&ts);
+
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_,
+          to_submit, wait_nr, flags | IORING_ENTER_EXT_ARG,
+          &arg, sizeof(arg)));
+  }
+
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_,
+        to_submit, wait_nr, flags, static_cast<void*>(0), _NSIG / 8));
+}
+
+std::size_t io_uring_reactor::reap_cqes(
+    op_queue<operation>* ops, bool& check_timers)
+{
+  std::size_t n = 0;
+  unsigned head = *cq_head_;
+  unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head)
+  {
+    const ::io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    void* ptr = reinterpret_cast<void*>(static_cast<uintptr_t>(cqe.user_data));
+    if (ptr == 0)
+    {
+      // Ignore completions of wakeups, cancellations and timeout updates.
+    }
+    else if (ptr == &timeout_)
+    {
+      check_timers = true;
+    }
+    else
+    {
+      ++n;
+      if (ops)
+      {
+        io_queue* q = static_cast<io_queue*>(ptr);
+
+#if defined(NET_TS_ENABLE_HANDLER_TRACKING)
+        // Trace the completed entry.
+        unsigned event_mask = 0;
+        if (cqe.res < 0)
+          event_mask |= NET_TS_HANDLER_REACTOR_ERROR_EVENT;
+        else if (q->op_type_ == write_op)
+          event_mask |= NET_TS_HANDLER_REACTOR_WRITE_EVENT;
+        else
+          event_mask |= NET_TS_HANDLER_REACTOR_READ_EVENT;
+        NET_TS_HANDLER_REACTOR_EVENTS((context(),
+              reinterpret_cast<uintmax_t>(q->descriptor_data_), event_mask));
+#endif // defined(NET_TS_ENABLE_HANDLER_TRACKING)
+
+        q->set_result(cqe.res);
+        ops->push(q);
+      }
+    }
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return n;
+}
+
+io_uring_reactor::io_queue::io_queue()
+  : operation(&io_uring_reactor::io_queue::do_complete),
+    descriptor_data_(0),
+    op_type_(0),
+    in_flight_(false),
+    polling_(false),
+    cancel_requested_(false)
+{
+}
+
+operation* io_uring_reactor::io_queue::perform_io(int result)
+{
+  descriptor_state* descriptor_data = descriptor_data_;
+  io_uring_reactor* reactor = descriptor_data->reactor_;
+  op_queue<operation> ops;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  bool cancelled = cancel_requested_ || descriptor_data->shutdown_;
+  in_flight_ = false;
+  cancel_requested_ = false;
+
+  if (reactor_op* op = op_queue_.front())
+  {
+    reactor_op::status status;
+    if (!polling_)
+      status = op->process_result(result);
+    else if (result < 0)
+    {
+      op->ec_ = std::error_code(-result,
+          std::experimental::net::error::get_system_category());
+      status = reactor_op::done;
+    }
+    else if (cancelled)
+      status = reactor_op::not_done;
+    else
+      status = op->perform();
+
+    if (!status && cancelled)
+    {
+      op->ec_ = std::experimental::net::error::operation_aborted;
+      status = reactor_op::done;
+    }
+
+    if (status)
+    {
+      op_queue_.pop();
+      ops.push(op);
+    }
+  }
+
+  if (descriptor_data->shutdown_)
+  {
+    if (!descriptor_data->has_in_flight_ops())
+    {
+      descriptor_lock.unlock();
+      reactor->free_descriptor_state(descriptor_data);
+    }
+  }
+  else if (op_queue_.front())
+  {
+    // Start the next operation or, if the current one could not complete,
+    // wait for the descriptor to become ready before trying it again.
+    ::io_uring_sqe sqe;
+    if (ops.empty())
+      reactor->prepare_poll(*this, sqe);
+    else
+      reactor->prepare_io(*this, sqe);
+    if (int error = reactor->submit_io(*this, sqe))
+    {
+      while (reactor_op* op = op_queue_.front())
+      {
+        op->ec_ = std::error_code(error,
+            std::experimental::net::error::get_system_category());
+        op_queue_.pop();
+        ops.push(op);
+      }
+    }
+  }
+
+  if (descriptor_lock.locked())
+    descriptor_lock.unlock();
+
+  // The first operation will be returned for completion now. The others will
+  // be posted for later.
+  operation* first_op = ops.front();
+  ops.pop();
+  if (!ops.empty())
+    reactor->scheduler_.post_deferred_completions(ops);
+
+  // If no user-initiated operation has completed, we need to compensate for
+  // the work_finished() call that the scheduler will make once this
+  // operation returns.
+  if (!first_op)
+    reactor->scheduler_.compensating_work_started();
+
+  return first_op;
+}
+
+void io_uring_reactor::io_queue::do_complete(
+    void* owner, operation* base,
+    const std::error_code& ec, std::size_t bytes_transferred)
+{
+  if (owner)
+  {
+    io_queue* q = static_cast<io_queue*>(base);
+    int result = static_cast<int>(static_cast<unsigned>(bytes_transferred));
+    if (operation* op = q->perform_io(result))
+    {
+      op->complete(owner, ec, 0);
+    }
+  }
+}
+
+io_uring_reactor::descriptor_state::descriptor_state(bool locking)
+  : mutex_(locking),
+    reactor_(0),
+    descriptor_(-1),
+    shutdown_(false)
+{
+  for (int i = 0; i < max_ops; ++i)
+  {
+    queues_[i].descriptor_data_ = this;
+    queues_[i].op_type_ = i;
+  }
+}
+
+bool io_uring_reactor::descriptor_state::has_in_flight_ops() const
+{
+  for (int i = 0; i < max_ops; ++i)
+    if (queues_[i].in_flight_)
+      return true;
+  return false;
+}
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
+#endif // NET_TS_DETAIL_IMPL_IO_URING_REACTOR_IPP
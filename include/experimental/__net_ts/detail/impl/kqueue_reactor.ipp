@@ -193,6 +193,14 @@ void kqueue_reactor::start_op(int op_type, socket_type descriptor,
     kqueue_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
     bool is_continuation, bool allow_speculative)
 {
+  if (op->deadline_ != 0)
+  {
+    // Operation deadlines are only implemented by the epoll reactor.
+    op->ec_ = std::experimental::net::error::operation_not_supported;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
   if (!descriptor_data)
   {
     op->ec_ = std::experimental::net::error::bad_descriptor;
@@ -372,7 +380,7 @@ void kqueue_reactor::deregister_internal_descriptor(socket_type descriptor,
   }
 }
 
-void kqueue_reactor::run(long usec, op_queue<operation>& ops)
+std::size_t kqueue_reactor::run(long usec, op_queue<operation>& ops)
 {
   mutex::scoped_lock lock(mutex_);
 
@@ -412,6 +420,7 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
 #endif // defined(NET_TS_ENABLE_HANDLER_TRACKING)
 
   // Dispatch the waiting events.
+  std::size_t n = 0;
   for (int i = 0; i < num_events; ++i)
   {
     void* ptr = reinterpret_cast<void*>(events[i].udata);
@@ -421,6 +430,7 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
     }
     else
     {
+      ++n;
       descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
       mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
@@ -478,7 +488,9 @@ void kqueue_reactor::run(long usec, op_queue<operation>& ops)
   }
 
   lock.lock();
-  timer_queues_.get_ready_timers(ops);
+  n += timer_queues_.get_ready_timers(ops);
+
+  return n;
 }
 
 void kqueue_reactor::interrupt()
@@ -142,6 +142,36 @@ std::error_code reactive_socket_service_base::cancel(
   return ec;
 }
 
+std::error_code reactive_socket_service_base::set_registration_flags(
+    reactive_socket_service_base::base_implementation_type& impl,
+    int flags, std::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = std::experimental::net::error::bad_descriptor;
+    return ec;
+  }
+
+  // Exclusive wake-ups cannot be combined with one-shot registration.
+  if ((flags & socket_base::registration_exclusive)
+      && (flags & socket_base::registration_one_shot))
+  {
+    ec = std::experimental::net::error::invalid_argument;
+    return ec;
+  }
+
+  if (int err = reactor_.set_registration_flags(
+        impl.socket_, impl.reactor_data_, flags))
+  {
+    ec = std::error_code(err,
+        std::experimental::net::error::get_system_category());
+    return ec;
+  }
+
+  ec = std::error_code();
+  return ec;
+}
+
 std::error_code reactive_socket_service_base::do_open(
     reactive_socket_service_base::base_implementation_type& impl,
     int af, int type, int protocol, std::error_code& ec)
@@ -170,6 +200,7 @@ std::error_code reactive_socket_service_base::do_open(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
+  impl.state_ |= socket_ops::new_socket_state;
   ec = std::error_code();
   return ec;
 }
@@ -177,7 +208,7 @@ std::error_code reactive_socket_service_base::do_open(
 std::error_code reactive_socket_service_base::do_assign(
     reactive_socket_service_base::base_implementation_type& impl, int type,
     const reactive_socket_service_base::native_handle_type& native_socket,
-    std::error_code& ec)
+    socket_ops::state_type state, std::error_code& ec)
 {
   if (is_open(impl))
   {
@@ -200,7 +231,7 @@ std::error_code reactive_socket_service_base::do_assign(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
-  impl.state_ |= socket_ops::possible_dup;
+  impl.state_ |= state;
   ec = std::error_code();
   return ec;
 }
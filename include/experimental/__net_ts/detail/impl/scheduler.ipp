@@ -17,6 +17,7 @@
 
 #include <experimental/__net_ts/detail/config.hpp>
 
+#include <experimental/__net_ts/detail/chrono.hpp>
 #include <experimental/__net_ts/detail/concurrency_hint.hpp>
 #include <experimental/__net_ts/detail/event.hpp>
 #include <experimental/__net_ts/detail/limits.hpp>
@@ -32,6 +33,14 @@ namespace net {
 inline namespace v1 {
 namespace detail {
 
+// The maximum number of high priority handlers run in succession while other
+// operations, including the task, are waiting.
+enum { scheduler_high_priority_burst = 16 };
+
+// The maximum number of handlers run in succession from a thread's local
+// queue before the shared queue, and with it the task, is given a turn.
+enum { scheduler_local_burst = 61 };
+
 struct scheduler::task_cleanup
 {
   ~task_cleanup()
@@ -43,11 +52,23 @@ struct scheduler::task_cleanup
           this_thread_->private_outstanding_work);
     }
     this_thread_->private_outstanding_work = 0;
+    scheduler_->unpark_task();
+
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+    if (scheduler_thread_statistics* s = this_thread_->statistics)
+    {
+      scheduler_thread_statistics::add(s->task_runs, 1);
+      scheduler_thread_statistics::add(s->task_events, task_events_);
+    }
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
 
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
+    std::size_t handlers = scheduler_->count_handlers(
+        this_thread_->private_op_queue);
     lock_->lock();
     scheduler_->task_interrupted_ = true;
+    scheduler_->shared_handlers_ += handlers;
     scheduler_->op_queue_.push(this_thread_->private_op_queue);
     scheduler_->op_queue_.push(&scheduler_->task_operation_);
   }
@@ -55,6 +76,9 @@ struct scheduler::task_cleanup
   scheduler* scheduler_;
   mutex::scoped_lock* lock_;
   thread_info* this_thread_;
+
+  // The number of events found by the task, as returned by its run function.
+  std::size_t task_events_;
 };
 
 struct scheduler::work_cleanup
@@ -73,11 +97,27 @@ struct scheduler::work_cleanup
     }
     this_thread_->private_outstanding_work = 0;
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+    if (scheduler_thread_statistics* s = this_thread_->statistics)
+      scheduler_thread_statistics::add(s->handlers, 1);
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
 #if defined(NET_TS_HAS_THREADS)
     if (!this_thread_->private_op_queue.empty())
     {
-      lock_->lock();
-      scheduler_->op_queue_.push(this_thread_->private_op_queue);
+      if (this_thread_->local_queue)
+      {
+        scheduler_->push_local(*this_thread_,
+            this_thread_->private_op_queue);
+      }
+      else
+      {
+        std::size_t handlers = scheduler_->count_handlers(
+            this_thread_->private_op_queue);
+        lock_->lock();
+        scheduler_->shared_handlers_ += handlers;
+        scheduler_->op_queue_.push(this_thread_->private_op_queue);
+      }
     }
 #endif // defined(NET_TS_HAS_THREADS)
   }
@@ -87,6 +127,196 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::idle_spinner
+{
+  explicit idle_spinner(long usec)
+    : usec_(usec),
+      started_(false)
+  {
+  }
+
+  // Returns true if the thread should keep polling for work rather than
+  // block. The spin period starts on the first call.
+  bool spin()
+  {
+    if (usec_ < 0)
+      return true;
+    if (usec_ == 0)
+      return false;
+#if defined(NET_TS_HAS_CHRONO)
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    if (!started_)
+    {
+      started_ = true;
+      deadline_ = now + chrono::microseconds(usec_);
+      return true;
+    }
+    return now < deadline_;
+#else // defined(NET_TS_HAS_CHRONO)
+    return false;
+#endif // defined(NET_TS_HAS_CHRONO)
+  }
+
+  // Tell the processor that the thread is in a spin-wait loop.
+  static void pause()
+  {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    __asm__ __volatile__ ("yield");
+#endif
+  }
+
+  long usec_;
+  bool started_;
+#if defined(NET_TS_HAS_CHRONO)
+  chrono::steady_clock::time_point deadline_;
+#endif // defined(NET_TS_HAS_CHRONO)
+};
+
+struct scheduler::statistics_timer
+{
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_timer(thread_info* this_thread, bool blocked)
+    : statistics_(this_thread->statistics),
+      blocked_(blocked)
+  {
+    if (statistics_)
+      start_ = chrono::steady_clock::now();
+  }
+
+  statistics_timer(scheduler* s, bool blocked)
+    : statistics_(0),
+      blocked_(blocked)
+  {
+    if (thread_info_base* this_thread = thread_call_stack::contains(s))
+      statistics_ = static_cast<thread_info*>(this_thread)->statistics;
+    if (statistics_)
+      start_ = chrono::steady_clock::now();
+  }
+
+  ~statistics_timer()
+  {
+    if (statistics_)
+    {
+      uint64_t ns = chrono::duration_cast<chrono::nanoseconds>(
+          chrono::steady_clock::now() - start_).count();
+      scheduler_thread_statistics::add(blocked_
+          ? statistics_->blocked_ns : statistics_->running_ns, ns);
+    }
+  }
+
+  scheduler_thread_statistics* statistics_;
+  bool blocked_;
+  chrono::steady_clock::time_point start_;
+#else // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_timer(thread_info*, bool) {}
+  statistics_timer(scheduler*, bool) {}
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+};
+
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+struct scheduler::statistics_registration
+{
+  statistics_registration(scheduler* s, thread_info& this_thread,
+      thread_info_base* outer_info)
+    : statistics_(0)
+  {
+    // A nested call on the same thread shares the counters of the outer call.
+    if (outer_info)
+    {
+      this_thread.statistics =
+        static_cast<thread_info*>(outer_info)->statistics;
+      return;
+    }
+
+    // Otherwise claim a set of counters that no other thread is using, and
+    // add a new set only if they are all taken. Neither needs the scheduler's
+    // mutex, so repeated calls to run_one(), poll_one() and the like are not
+    // serialised on it.
+    std::atomic<scheduler_thread_statistics*>& head = s->thread_statistics_;
+    scheduler_thread_statistics* t = head.load(std::memory_order_acquire);
+    for (; t; t = t->next)
+    {
+      if (!t->claimed.load(std::memory_order_relaxed)
+          && !t->claimed.exchange(true, std::memory_order_acquire))
+        break;
+    }
+
+    if (!t)
+    {
+      t = new scheduler_thread_statistics;
+      t->claimed.store(true, std::memory_order_relaxed);
+      t->next = head.load(std::memory_order_relaxed);
+      while (!head.compare_exchange_weak(t->next, t,
+            std::memory_order_release, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    statistics_ = t;
+    this_thread.statistics = t;
+  }
+
+  ~statistics_registration()
+  {
+    // The counters are kept, so that their totals are still included in the
+    // scheduler's statistics, and may be claimed by the next thread to run.
+    if (statistics_)
+      statistics_->claimed.store(false, std::memory_order_release);
+  }
+
+  scheduler_thread_statistics* statistics_;
+};
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
+#if defined(NET_TS_HAS_THREADS)
+struct scheduler::local_queue_registration
+{
+  local_queue_registration(scheduler* s, thread_info& this_thread)
+    : scheduler_(s),
+      this_thread_(&this_thread)
+  {
+    mutex::scoped_lock lock(scheduler_->mutex_);
+    this_thread_->local_queue = &local_queue_;
+    local_queue_.stopped = scheduler_->stopped_;
+    local_queue_.next = scheduler_->local_queues_;
+    if (scheduler_->local_queues_)
+      scheduler_->local_queues_->prev = &local_queue_;
+    scheduler_->local_queues_ = &local_queue_;
+  }
+
+  ~local_queue_registration()
+  {
+    // Unlink the queue and return any work that is left on it to the shared
+    // queue, where it can be picked up by the remaining threads.
+    mutex::scoped_lock lock(scheduler_->mutex_);
+    if (scheduler_->local_queues_ == &local_queue_)
+      scheduler_->local_queues_ = local_queue_.next;
+    if (local_queue_.prev)
+      local_queue_.prev->next = local_queue_.next;
+    if (local_queue_.next)
+      local_queue_.next->prev = local_queue_.prev;
+    this_thread_->local_queue = 0;
+
+    std::experimental::net::detail::mutex::scoped_lock local_lock(
+        local_queue_.mutex_);
+    if (!local_queue_.ops.empty())
+    {
+      scheduler_->op_queue_.push(local_queue_.ops);
+      scheduler_->shared_handlers_ += local_queue_.size;
+      local_queue_.size = 0;
+      local_lock.unlock();
+      scheduler_->wake_one_thread_and_unlock(lock);
+    }
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+  scheduler_local_queue local_queue_;
+};
+#endif // defined(NET_TS_HAS_THREADS)
+
 scheduler::scheduler(
     std::experimental::net::execution_context& ctx, int concurrency_hint)
   : std::experimental::net::detail::execution_context_service_base<scheduler>(ctx),
@@ -98,20 +328,59 @@ scheduler::scheduler(
     task_(0),
     task_interrupted_(true),
     outstanding_work_(0),
+    high_priority_burst_(0),
+    task_due_(false),
+    shared_handlers_(0),
+    high_priority_ops_(0),
     stopped_(false),
     shutdown_(false),
-    concurrency_hint_(concurrency_hint)
+    concurrency_hint_(concurrency_hint),
+#if defined(NET_TS_HAS_THREADS)
+    work_stealing_(!one_thread_
+        && NET_TS_CONCURRENCY_HINT_IS_WORK_STEALING(concurrency_hint)),
+#else // defined(NET_TS_HAS_THREADS)
+    work_stealing_(false),
+#endif // defined(NET_TS_HAS_THREADS)
+    local_queues_(0),
+    idle_threads_(0),
+    idle_spin_usec_(0),
+    full_polling_(false),
+    spinning_threads_(0)
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+    , thread_statistics_(0)
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+    , task_parked_(false),
+    event_waiters_(0)
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
 {
   NET_TS_HANDLER_TRACKING_INIT;
 }
 
+scheduler::~scheduler()
+{
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  scheduler_thread_statistics* t = thread_statistics_.load();
+  while (t)
+  {
+    scheduler_thread_statistics* next = t->next;
+    delete t;
+    t = next;
+  }
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+}
+
 void scheduler::shutdown()
 {
   mutex::scoped_lock lock(mutex_);
   shutdown_ = true;
+  drain_injected();
   lock.unlock();
 
   // Destroy handler objects.
+  shared_handlers_ = 0;
+  op_queue_.push(high_op_queue_);
+  op_queue_.push(background_op_queue_);
   while (!op_queue_.empty())
   {
     operation* o = op_queue_.front();
@@ -146,8 +415,62 @@ std::size_t scheduler::run(std::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.local_queue = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_registration stats_reg(this, this_thread, ctx.next_by_key());
+  (void)stats_reg;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
+#if defined(NET_TS_HAS_THREADS)
+  if (work_stealing_)
+  {
+    local_queue_registration reg(this, this_thread);
+    (void)reg;
+
+    // Handlers on this thread's local queue are run without touching the
+    // shared queue. The scheduler's mutex is only locked once the local queue
+    // has been drained.
+    std::size_t n = 0;
+    std::size_t local_burst = 0;
+    for (;;)
+    {
+      // High priority handlers on the shared queue are run ahead of those on
+      // the local queue. Otherwise one item is taken from the shared queue
+      // after every burst of local handlers, or as soon as other threads have
+      // injected operations, so that a handler that keeps reposting itself
+      // cannot starve the task, the timers or the shared queue.
+      if (high_priority_ops_ > 0
+          || local_burst >= scheduler_local_burst
+          || has_injected_ops())
+      {
+        local_burst = 0;
+        mutex::scoped_lock lock(mutex_);
+        if (do_poll_one(lock, this_thread, ec))
+        {
+          if (n != (std::numeric_limits<std::size_t>::max)())
+            ++n;
+          continue;
+        }
+      }
+
+      if (do_run_local_one(this_thread, ec))
+        ++local_burst;
+      else
+      {
+        local_burst = 0;
+        mutex::scoped_lock lock(mutex_);
+        if (!do_run_one(lock, this_thread, ec))
+          break;
+      }
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    }
+    return n;
+  }
+#endif // defined(NET_TS_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
@@ -168,8 +491,14 @@ std::size_t scheduler::run_one(std::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.local_queue = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_registration stats_reg(this, this_thread, ctx.next_by_key());
+  (void)stats_reg;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
   mutex::scoped_lock lock(mutex_);
 
   return do_run_one(lock, this_thread, ec);
@@ -186,8 +515,14 @@ std::size_t scheduler::wait_one(long usec, std::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.local_queue = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_registration stats_reg(this, this_thread, ctx.next_by_key());
+  (void)stats_reg;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
   mutex::scoped_lock lock(mutex_);
 
   return do_wait_one(lock, this_thread, usec, ec);
@@ -204,8 +539,14 @@ std::size_t scheduler::poll(std::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.local_queue = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_registration stats_reg(this, this_thread, ctx.next_by_key());
+  (void)stats_reg;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(NET_TS_HAS_THREADS)
@@ -214,7 +555,10 @@ std::size_t scheduler::poll(std::error_code& ec)
   // queue now.
   if (one_thread_)
     if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+    {
+      shared_handlers_ += count_handlers(outer_info->private_op_queue);
       op_queue_.push(outer_info->private_op_queue);
+    }
 #endif // defined(NET_TS_HAS_THREADS)
 
   std::size_t n = 0;
@@ -235,8 +579,14 @@ std::size_t scheduler::poll_one(std::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.local_queue = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  statistics_registration stats_reg(this, this_thread, ctx.next_by_key());
+  (void)stats_reg;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(NET_TS_HAS_THREADS)
@@ -245,7 +595,10 @@ std::size_t scheduler::poll_one(std::error_code& ec)
   // queue now.
   if (one_thread_)
     if (thread_info* outer_info = static_cast<thread_info*>(ctx.next_by_key()))
+    {
+      shared_handlers_ += count_handlers(outer_info->private_op_queue);
       op_queue_.push(outer_info->private_op_queue);
+    }
 #endif // defined(NET_TS_HAS_THREADS)
 
   return do_poll_one(lock, this_thread, ec);
@@ -267,6 +620,11 @@ void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+  for (scheduler_local_queue* q = local_queues_; q; q = q->next)
+  {
+    std::experimental::net::detail::mutex::scoped_lock local_lock(q->mutex_);
+    q->stopped = false;
+  }
 }
 
 void scheduler::compensating_work_started()
@@ -279,6 +637,21 @@ void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
 #if defined(NET_TS_HAS_THREADS)
+  if (work_stealing_ && !is_continuation)
+  {
+    if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    {
+      if (static_cast<thread_info*>(this_thread)->local_queue)
+      {
+        work_started();
+        op_queue<operation> ops;
+        ops.push(op);
+        push_local(*static_cast<thread_info*>(this_thread), ops);
+        return;
+      }
+    }
+  }
+
   if (one_thread_ || is_continuation)
   {
     if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -293,11 +666,88 @@ void scheduler::post_immediate_completion(
 #endif // defined(NET_TS_HAS_THREADS)
 
   work_started();
+  if (!thread_call_stack::contains(this) && inject(op))
+    return;
+
   mutex::scoped_lock lock(mutex_);
+  drain_injected();
+  ++shared_handlers_;
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::post_immediate_completions(std::size_t n,
+    op_queue<scheduler::operation>& ops, bool is_continuation)
+{
+  if (ops.empty())
+    return;
+
+#if defined(NET_TS_HAS_THREADS)
+  if (work_stealing_ && !is_continuation)
+  {
+    if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    {
+      if (static_cast<thread_info*>(this_thread)->local_queue)
+      {
+        increment(outstanding_work_, static_cast<long>(n));
+        push_local(*static_cast<thread_info*>(this_thread), ops);
+        return;
+      }
+    }
+  }
+
+  if (one_thread_ || is_continuation)
+  {
+    if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    {
+      static_cast<thread_info*>(this_thread)->private_outstanding_work
+        += static_cast<long>(n);
+      static_cast<thread_info*>(this_thread)->private_op_queue.push(ops);
+      return;
+    }
+  }
+#else // defined(NET_TS_HAS_THREADS)
+  (void)is_continuation;
+#endif // defined(NET_TS_HAS_THREADS)
+
+  // Operations already injected by this or another thread must run first,
+  // so that the batch keeps its place relative to earlier calls to post().
+  increment(outstanding_work_, static_cast<long>(n));
+  std::size_t handlers = count_handlers(ops);
+  mutex::scoped_lock lock(mutex_);
+  drain_injected();
+  shared_handlers_ += handlers;
+  op_queue_.push(ops);
+  wake_one_thread_and_unlock(lock);
+}
+
+void scheduler::post_priority_completion(scheduler::operation* op,
+    int priority, bool is_continuation)
+{
+  if (priority == normal_priority)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  // Operations with a priority always go on to the shared queues, as the
+  // thread-private and local queues are serviced in FIFO order.
+  work_started();
+  mutex::scoped_lock lock(mutex_);
+  drain_injected();
+  ++shared_handlers_;
+  if (priority == high_priority)
+  {
+    high_op_queue_.push(op);
+    ++high_priority_ops_;
+  }
+  else
+  {
+    background_op_queue_.push(op);
+  }
+  wake_one_thread_and_unlock(lock);
+}
+
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
 #if defined(NET_TS_HAS_THREADS)
@@ -311,7 +761,12 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
   }
 #endif // defined(NET_TS_HAS_THREADS)
 
+  if (!thread_call_stack::contains(this) && inject(op))
+    return;
+
   mutex::scoped_lock lock(mutex_);
+  drain_injected();
+  ++shared_handlers_;
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
@@ -332,7 +787,10 @@ void scheduler::post_deferred_completions(
     }
 #endif // defined(NET_TS_HAS_THREADS)
 
+    std::size_t handlers = count_handlers(ops);
     mutex::scoped_lock lock(mutex_);
+    drain_injected();
+    shared_handlers_ += handlers;
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
   }
@@ -342,7 +800,12 @@ void scheduler::do_dispatch(
     scheduler::operation* op)
 {
   work_started();
+  if (inject(op))
+    return;
+
   mutex::scoped_lock lock(mutex_);
+  drain_injected();
+  ++shared_handlers_;
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
@@ -358,31 +821,42 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const std::error_code& ec)
 {
+  idle_spinner spinner(full_polling_ ? -1 : idle_spin_usec_);
+
   while (!stopped_)
   {
-    if (!op_queue_.empty())
+    drain_injected();
+
+    if (has_ready_ops())
     {
       // Prepare to execute first handler from queue.
-      operation* o = op_queue_.front();
-      op_queue_.pop();
-      bool more_handlers = (!op_queue_.empty());
+      operation* o = pop_ready(ready_queue());
+      bool more_handlers = has_ready_ops();
 
       if (o == &task_operation_)
       {
-        task_interrupted_ = more_handlers;
+        // While spinning, the task is polled rather than blocked on, so there
+        // is no need for other threads to interrupt it.
+        bool poll_task = more_handlers || spinner.spin();
+        task_interrupted_ = poll_task;
 
         if (more_handlers && !one_thread_)
           wakeup_event_.unlock_and_signal_one(lock);
         else
           lock.unlock();
 
-        task_cleanup on_exit = { this, &lock, &this_thread };
+        task_cleanup on_exit = { this, &lock, &this_thread, 0 };
         (void)on_exit;
 
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        if (!poll_task && !park_task())
+          poll_task = true;
+        this_thread.clear_loop_time();
+        statistics_timer timer(&this_thread, !poll_task);
+        on_exit.task_events_ = task_->run(
+            poll_task ? 0 : -1, this_thread.private_op_queue);
       }
       else
       {
@@ -398,21 +872,131 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         (void)on_exit;
 
         // Complete the operation. May throw an exception. Deletes the object.
+        this_thread.clear_loop_time();
+        statistics_timer timer(&this_thread, false);
         o->complete(this, ec, task_result);
 
         return 1;
       }
     }
+#if defined(NET_TS_HAS_THREADS)
+    else if (this_thread.local_queue)
+    {
+      // Count ourselves as idle before looking at the peers' queues, so that
+      // any peer adding to its queue after we have looked will wake us.
+      ++idle_threads_;
+      bool stolen = steal_work(this_thread);
+      if (!stolen)
+        wait_for_work(lock, spinner);
+      --idle_threads_;
+
+      if (stolen)
+      {
+        lock.unlock();
+        if (std::size_t n = do_run_local_one(this_thread, ec))
+          return n;
+        lock.lock();
+      }
+    }
+#endif // defined(NET_TS_HAS_THREADS)
     else
     {
-      wakeup_event_.clear(lock);
-      wakeup_event_.wait(lock);
+      wait_for_work(lock, spinner);
     }
   }
 
   return 0;
 }
 
+#if defined(NET_TS_HAS_THREADS)
+std::size_t scheduler::do_run_local_one(
+    scheduler::thread_info& this_thread,
+    const std::error_code& ec)
+{
+  scheduler_local_queue& q = *this_thread.local_queue;
+
+  std::experimental::net::detail::mutex::scoped_lock local_lock(q.mutex_);
+  operation* o = q.ops.front();
+  if (q.stopped || o == 0)
+    return 0;
+  q.ops.pop();
+  --q.size;
+  local_lock.unlock();
+
+  std::size_t task_result = o->task_result_;
+
+  // Ensure the count of outstanding work is decremented on block exit. Any
+  // private operations are moved to the local queue, so the scheduler's lock
+  // is not needed.
+  work_cleanup on_exit = { this, 0, &this_thread };
+  (void)on_exit;
+
+  // Complete the operation. May throw an exception. Deletes the object.
+  this_thread.clear_loop_time();
+  statistics_timer timer(&this_thread, false);
+  o->complete(this, ec, task_result);
+
+  return 1;
+}
+
+void scheduler::push_local(scheduler::thread_info& this_thread,
+    op_queue<scheduler::operation>& ops)
+{
+  std::size_t count = 0;
+  for (operation* o = ops.front(); o; o = op_queue_access::next(o))
+    ++count;
+
+  scheduler_local_queue& q = *this_thread.local_queue;
+  std::experimental::net::detail::mutex::scoped_lock local_lock(q.mutex_);
+  q.ops.push(ops);
+  q.size += count;
+  local_lock.unlock();
+
+  // Only touch the scheduler's mutex if there is a thread waiting for work.
+  if (idle_threads_ > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
+      lock.unlock();
+  }
+}
+
+bool scheduler::steal_work(scheduler::thread_info& this_thread)
+{
+  scheduler_local_queue* own = this_thread.local_queue;
+
+  // Visit the peers in list order starting after our own queue, so that idle
+  // threads do not all converge on the same victim.
+  scheduler_local_queue* victim = own->next ? own->next : local_queues_;
+  for (; victim != own; victim = victim->next ? victim->next : local_queues_)
+  {
+    std::experimental::net::detail::mutex::scoped_lock victim_lock(
+        victim->mutex_);
+    if (victim->size == 0)
+      continue;
+
+    // Take the older half of the victim's queue.
+    std::size_t count = (victim->size + 1) / 2;
+    op_queue<operation> stolen;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      operation* o = victim->ops.front();
+      victim->ops.pop();
+      stolen.push(o);
+    }
+    victim->size -= count;
+    victim_lock.unlock();
+
+    std::experimental::net::detail::mutex::scoped_lock own_lock(own->mutex_);
+    own->ops.push(stolen);
+    own->size += count;
+    return true;
+  }
+
+  return false;
+}
+#endif // defined(NET_TS_HAS_THREADS)
+
 std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread, long usec,
     const std::error_code& ec)
@@ -420,19 +1004,22 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  drain_injected();
+  op_queue<operation>* q = &ready_queue();
+  operation* o = q->front();
   if (o == 0)
   {
-    wakeup_event_.clear(lock);
-    wakeup_event_.wait_for_usec(lock, usec);
+    wait_on_event(lock, usec);
     usec = 0; // Wait at most once.
-    o = op_queue_.front();
+    drain_injected();
+    q = &ready_queue();
+    o = q->front();
   }
 
   if (o == &task_operation_)
   {
-    op_queue_.pop();
-    bool more_handlers = (!op_queue_.empty());
+    pop_ready(*q);
+    bool more_handlers = has_ready_ops();
 
     task_interrupted_ = more_handlers;
 
@@ -442,16 +1029,21 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       lock.unlock();
 
     {
-      task_cleanup on_exit = { this, &lock, &this_thread };
+      task_cleanup on_exit = { this, &lock, &this_thread, 0 };
       (void)on_exit;
 
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
-      task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
+      if (more_handlers || (usec != 0 && !park_task()))
+        usec = 0;
+      this_thread.clear_loop_time();
+      statistics_timer timer(&this_thread, usec != 0);
+      on_exit.task_events_ = task_->run(usec, this_thread.private_op_queue);
     }
 
-    o = op_queue_.front();
+    q = &ready_queue();
+    o = q->front();
     if (o == &task_operation_)
     {
       if (!one_thread_)
@@ -463,8 +1055,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (o == 0)
     return 0;
 
-  op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  pop_ready(*q);
+  bool more_handlers = has_ready_ops();
 
   std::size_t task_result = o->task_result_;
 
@@ -478,6 +1070,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  this_thread.clear_loop_time();
+  statistics_timer timer(&this_thread, false);
   o->complete(this, ec, task_result);
 
   return 1;
@@ -490,23 +1084,28 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  drain_injected();
+  op_queue<operation>* q = &ready_queue();
+  operation* o = q->front();
   if (o == &task_operation_)
   {
-    op_queue_.pop();
+    pop_ready(*q);
     lock.unlock();
 
     {
-      task_cleanup c = { this, &lock, &this_thread };
+      task_cleanup c = { this, &lock, &this_thread, 0 };
       (void)c;
 
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
-      task_->run(0, this_thread.private_op_queue);
+      this_thread.clear_loop_time();
+      statistics_timer timer(&this_thread, false);
+      c.task_events_ = task_->run(0, this_thread.private_op_queue);
     }
 
-    o = op_queue_.front();
+    q = &ready_queue();
+    o = q->front();
     if (o == &task_operation_)
     {
       wakeup_event_.maybe_unlock_and_signal_one(lock);
@@ -517,8 +1116,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (o == 0)
     return 0;
 
-  op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  pop_ready(*q);
+  bool more_handlers = has_ready_ops();
 
   std::size_t task_result = o->task_result_;
 
@@ -532,15 +1131,65 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  this_thread.clear_loop_time();
+  statistics_timer timer(&this_thread, false);
   o->complete(this, ec, task_result);
 
   return 1;
 }
 
+op_queue<scheduler::operation>& scheduler::ready_queue()
+{
+  // High priority handlers go first, unless a full burst of them has just
+  // been run and there is something else waiting.
+  if (!high_op_queue_.empty()
+      && (high_priority_burst_ < scheduler_high_priority_burst
+        || (op_queue_.empty() && background_op_queue_.empty())))
+    return high_op_queue_;
+
+  // Background handlers only go ahead of the task, and then only every other
+  // time, so that neither is starved by the other.
+  if (!background_op_queue_.empty()
+      && (op_queue_.empty()
+        || (op_queue_.front() == &task_operation_ && !task_due_)))
+    return background_op_queue_;
+
+  return op_queue_;
+}
+
+scheduler::operation* scheduler::pop_ready(op_queue<operation>& q)
+{
+  operation* o = q.front();
+  q.pop();
+  if (o != &task_operation_)
+    --shared_handlers_;
+
+  if (&q == &high_op_queue_)
+  {
+    ++high_priority_burst_;
+    --high_priority_ops_;
+  }
+  else
+  {
+    high_priority_burst_ = 0;
+    if (&q == &background_op_queue_)
+      task_due_ = true;
+    else if (o == &task_operation_)
+      task_due_ = false;
+  }
+
+  return o;
+}
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
+  for (scheduler_local_queue* q = local_queues_; q; q = q->next)
+  {
+    std::experimental::net::detail::mutex::scoped_lock local_lock(q->mutex_);
+    q->stopped = true;
+  }
   wakeup_event_.signal_all(lock);
 
   if (!task_interrupted_ && task_)
@@ -550,9 +1199,218 @@ void scheduler::stop_all_threads(
   }
 }
 
+void scheduler::set_idle_spin(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  idle_spin_usec_ = usec;
+}
+
+void scheduler::set_full_polling(bool enable)
+{
+  mutex::scoped_lock lock(mutex_);
+  full_polling_ = enable;
+}
+
+void scheduler::get_statistics(io_context_statistics& s)
+{
+  s = io_context_statistics();
+  s.outstanding_work = static_cast<std::size_t>(outstanding_work_);
+
+  // Injected operations are moved on to the shared queue first, so that
+  // they are included in its count.
+  mutex::scoped_lock lock(mutex_);
+  drain_injected();
+  s.queued_handlers = shared_handlers_;
+
+  for (scheduler_local_queue* q = local_queues_; q; q = q->next)
+  {
+    std::experimental::net::detail::mutex::scoped_lock local_lock(q->mutex_);
+    s.queued_handlers += q->size;
+  }
+  lock.unlock();
+
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  s.counters_enabled = true;
+  const scheduler_thread_statistics* t =
+    thread_statistics_.load(std::memory_order_acquire);
+  for (; t; t = t->next)
+  {
+    s.handlers_executed += t->handlers.load(std::memory_order_relaxed);
+    s.reactor_runs += t->task_runs.load(std::memory_order_relaxed);
+    s.reactor_events += t->task_events.load(std::memory_order_relaxed);
+    s.blocked_nanoseconds += t->blocked_ns.load(std::memory_order_relaxed);
+    s.running_nanoseconds += t->running_ns.load(std::memory_order_relaxed);
+  }
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+}
+
+bool scheduler::has_pending_handlers()
+{
+  if (thread_info_base* t = thread_call_stack::contains(this))
+  {
+    thread_info* this_thread = static_cast<thread_info*>(t);
+    if (!this_thread->private_op_queue.empty())
+      return true;
+
+    if (scheduler_local_queue* q = this_thread->local_queue)
+    {
+      std::experimental::net::detail::mutex::scoped_lock local_lock(q->mutex_);
+      if (q->size > 0)
+        return true;
+    }
+  }
+
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  if (!injected_ops_.empty())
+    return true;
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+
+  mutex::scoped_lock lock(mutex_);
+
+  if (!high_op_queue_.empty() || !background_op_queue_.empty())
+    return true;
+
+  operation* o = op_queue_.front();
+  return o && (o != &task_operation_ || op_queue_access::next(o) != 0);
+}
+
+void scheduler::wait_for_work(mutex::scoped_lock& lock,
+    scheduler::idle_spinner& spinner)
+{
+  if (spinner.spin())
+  {
+    ++spinning_threads_;
+    lock.unlock();
+    idle_spinner::pause();
+    lock.lock();
+    --spinning_threads_;
+  }
+  else
+  {
+    wait_on_event(lock, -1);
+  }
+}
+
+void scheduler::wait_on_event(mutex::scoped_lock& lock, long usec)
+{
+  wakeup_event_.clear(lock);
+
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  // Announce that we are about to block before checking the injection queue.
+  // A thread that injects an operation after the check will see the count,
+  // and will lock the mutex to signal the event.
+  ++event_waiters_;
+  if (!injected_ops_.empty())
+  {
+    --event_waiters_;
+    return;
+  }
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+
+  {
+    statistics_timer timer(this, true);
+    if (usec < 0)
+      wakeup_event_.wait(lock);
+    else
+      wakeup_event_.wait_for_usec(lock, usec);
+  }
+
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  --event_waiters_;
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+}
+
+bool scheduler::inject(scheduler::operation* op)
+{
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  if (!mutex_.enabled())
+    return false;
+
+  // Only the push that makes the queue non-empty needs to wake a thread, as
+  // whichever thread drains the queue takes every operation on it.
+  if (!injected_ops_.push(op))
+    return true;
+
+  // Only wake a thread that is actually blocked. A thread that is running
+  // handlers, or polling, will drain the injection queue before it blocks.
+  // Clearing the flag ensures that each park costs at most one interrupt.
+  if (task_parked_.exchange(false))
+  {
+    task_->interrupt();
+  }
+  else if (event_waiters_.load() > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
+      lock.unlock();
+  }
+
+  return true;
+#else // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  (void)op;
+  return false;
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+}
+
+bool scheduler::has_injected_ops() const
+{
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  return !injected_ops_.empty();
+#else // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  return false;
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+}
+
+void scheduler::drain_injected()
+{
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  if (!injected_ops_.empty())
+    shared_handlers_ += injected_ops_.pop_all(op_queue_);
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+}
+
+std::size_t scheduler::count_handlers(op_queue<operation>& ops)
+{
+  std::size_t n = 0;
+  for (operation* o = ops.front(); o; o = op_queue_access::next(o))
+    if (o != &task_operation_)
+      ++n;
+  return n;
+}
+
+bool scheduler::park_task()
+{
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  // Announce that we are about to block before checking the injection queue.
+  // A thread that injects an operation after the check will see the flag,
+  // and will interrupt the task.
+  task_parked_.store(true);
+  if (!injected_ops_.empty())
+  {
+    task_parked_.store(false, std::memory_order_relaxed);
+    return false;
+  }
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  return true;
+}
+
+void scheduler::unpark_task()
+{
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  task_parked_.store(false, std::memory_order_relaxed);
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+}
+
 void scheduler::wake_one_thread_and_unlock(
     mutex::scoped_lock& lock)
 {
+  // A spinning thread will find the work without being woken.
+  if (spinning_threads_ > 0)
+  {
+    lock.unlock();
+    return;
+  }
+
   if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
   {
     if (!task_interrupted_ && task_)
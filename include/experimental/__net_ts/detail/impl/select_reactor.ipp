@@ -27,6 +27,7 @@
 #include <experimental/__net_ts/detail/select_reactor.hpp>
 #include <experimental/__net_ts/detail/signal_blocker.hpp>
 #include <experimental/__net_ts/detail/socket_ops.hpp>
+#include <experimental/__net_ts/error.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
 
@@ -146,6 +147,14 @@ void select_reactor::start_op(int op_type, socket_type descriptor,
     select_reactor::per_descriptor_data&, reactor_op* op,
     bool is_continuation, bool)
 {
+  if (op->deadline_ != 0)
+  {
+    // Operation deadlines are only implemented by the epoll reactor.
+    op->ec_ = std::experimental::net::error::operation_not_supported;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
   std::experimental::net::detail::mutex::scoped_lock lock(mutex_);
 
   if (shutdown_)
@@ -183,14 +192,14 @@ void select_reactor::deregister_internal_descriptor(
     op_queue_[i].cancel_operations(descriptor, ops);
 }
 
-void select_reactor::run(long usec, op_queue<operation>& ops)
+std::size_t select_reactor::run(long usec, op_queue<operation>& ops)
 {
   std::experimental::net::detail::mutex::scoped_lock lock(mutex_);
 
 #if defined(NET_TS_HAS_IOCP)
   // Check if the thread is supposed to stop.
   if (stop_thread_)
-    return;
+    return 0;
 #endif // defined(NET_TS_HAS_IOCP)
 
   // Set up the descriptor sets.
@@ -221,7 +230,7 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
   // We can return immediately if there's no work to do and the reactor is
   // not supposed to block.
   if (!usec && !have_work_to_do)
-    return;
+    return 0;
 
   // Determine how long to block while waiting for events.
   timeval tv_buf = { 0, 0 };
@@ -244,8 +253,11 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
   lock.lock();
 
   // Dispatch all ready operations.
+  std::size_t n = 0;
   if (retval > 0)
   {
+    n = static_cast<std::size_t>(retval);
+
 #if defined(NET_TS_WINDOWS) || defined(__CYGWIN__)
     // Connection operations on Windows use both except and write fd_sets.
     fd_sets_[except_op].perform(op_queue_[connect_op], ops);
@@ -257,7 +269,9 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
     for (int i = max_select_ops - 1; i >= 0; --i)
       fd_sets_[i].perform(op_queue_[i], ops);
   }
-  timer_queues_.get_ready_timers(ops);
+  n += timer_queues_.get_ready_timers(ops);
+
+  return n;
 }
 
 void select_reactor::interrupt()
@@ -95,7 +95,12 @@ inline socket_type call_accept(SockLenType msghdr::*,
     socket_type s, socket_addr_type* addr, std::size_t* addrlen)
 {
   SockLenType tmp_addrlen = addrlen ? (SockLenType)*addrlen : 0;
+#if defined(NET_TS_HAS_SOCK_NONBLOCK)
+  socket_type result = ::accept4(s, addr, addrlen ? &tmp_addrlen : 0,
+      SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else // defined(NET_TS_HAS_SOCK_NONBLOCK)
   socket_type result = ::accept(s, addr, addrlen ? &tmp_addrlen : 0);
+#endif // defined(NET_TS_HAS_SOCK_NONBLOCK)
   if (addrlen)
     *addrlen = (std::size_t)tmp_addrlen;
   return result;
@@ -269,6 +274,59 @@ bool non_blocking_accept(socket_type s,
   }
 }
 
+#if defined(NET_TS_HAS_IO_URING)
+
+bool prepare_io_uring_accept(::io_uring_sqe& sqe, socket_type s,
+    state_type state, socket_addr_type* addr, socklen_t* addrlen)
+{
+  // Operations on a socket in user-controlled non-blocking mode must fail
+  // with would_block rather than wait, so they cannot be submitted directly.
+  if (state & user_set_non_blocking)
+    return false;
+
+  sqe.opcode = IORING_OP_ACCEPT;
+  sqe.fd = s;
+  sqe.addr = reinterpret_cast<uintptr_t>(addr);
+  sqe.addr2 = reinterpret_cast<uintptr_t>(addr ? addrlen : 0);
+#if defined(NET_TS_HAS_SOCK_NONBLOCK)
+  sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+#endif // defined(NET_TS_HAS_SOCK_NONBLOCK)
+  return true;
+}
+
+bool complete_io_uring_accept(state_type state, int result,
+    std::error_code& ec, socket_type& new_socket)
+{
+  // Check if operation succeeded.
+  if (result >= 0)
+  {
+    new_socket = result;
+    ec = std::error_code();
+    return true;
+  }
+
+  new_socket = invalid_socket;
+  ec = std::error_code(-result,
+      std::experimental::net::error::get_system_category());
+
+  // Retry operation if interrupted by signal or not yet ready.
+  if (ec == std::experimental::net::error::interrupted
+      || ec == std::experimental::net::error::would_block
+      || ec == std::experimental::net::error::try_again)
+    return false;
+
+  if (ec == std::experimental::net::error::connection_aborted)
+    return (state & enable_connection_aborted) != 0;
+#if defined(EPROTO)
+  if (ec.value() == EPROTO)
+    return (state & enable_connection_aborted) != 0;
+#endif // defined(EPROTO)
+
+  return true;
+}
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #endif // defined(NET_TS_HAS_IOCP)
 
 template <typename SockLenType>
@@ -903,6 +961,55 @@ bool non_blocking_recv(socket_type s,
   }
 }
 
+#if defined(NET_TS_HAS_IO_URING)
+
+bool prepare_io_uring_recv(::io_uring_sqe& sqe, socket_type s,
+    state_type state, buf* bufs, size_t count, int flags)
+{
+  // Operations on a socket in user-controlled non-blocking mode must fail
+  // with would_block rather than wait, so they cannot be submitted directly.
+  if ((state & user_set_non_blocking) || count != 1)
+    return false;
+
+  sqe.opcode = IORING_OP_RECV;
+  sqe.fd = s;
+  sqe.addr = reinterpret_cast<uintptr_t>(bufs[0].iov_base);
+  sqe.len = static_cast<__u32>(bufs[0].iov_len);
+  sqe.msg_flags = flags;
+  return true;
+}
+
+bool complete_io_uring_recv(int result, bool is_stream,
+    std::error_code& ec, size_t& bytes_transferred)
+{
+  bytes_transferred = 0;
+
+  // Check for end of stream.
+  if (is_stream && result == 0)
+  {
+    ec = std::experimental::net::error::eof;
+    return true;
+  }
+
+  // Operation is complete.
+  if (result >= 0)
+  {
+    ec = std::error_code();
+    bytes_transferred = result;
+    return true;
+  }
+
+  ec = std::error_code(-result,
+      std::experimental::net::error::get_system_category());
+
+  // Check if we need to run the operation again.
+  return ec != std::experimental::net::error::interrupted
+    && ec != std::experimental::net::error::would_block
+    && ec != std::experimental::net::error::try_again;
+}
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #endif // defined(NET_TS_HAS_IOCP)
 
 signed_size_type recvfrom(socket_type s, buf* bufs, size_t count,
@@ -1267,6 +1374,48 @@ bool non_blocking_send(socket_type s,
   }
 }
 
+#if defined(NET_TS_HAS_IO_URING)
+
+bool prepare_io_uring_send(::io_uring_sqe& sqe, socket_type s,
+    state_type state, const buf* bufs, size_t count, int flags)
+{
+  // Operations on a socket in user-controlled non-blocking mode must fail
+  // with would_block rather than wait, so they cannot be submitted directly.
+  if ((state & user_set_non_blocking) || count != 1)
+    return false;
+
+  sqe.opcode = IORING_OP_SEND;
+  sqe.fd = s;
+  sqe.addr = reinterpret_cast<uintptr_t>(bufs[0].iov_base);
+  sqe.len = static_cast<__u32>(bufs[0].iov_len);
+  sqe.msg_flags = flags | MSG_NOSIGNAL;
+  return true;
+}
+
+bool complete_io_uring_send(int result,
+    std::error_code& ec, size_t& bytes_transferred)
+{
+  bytes_transferred = 0;
+
+  // Operation is complete.
+  if (result >= 0)
+  {
+    ec = std::error_code();
+    bytes_transferred = result;
+    return true;
+  }
+
+  ec = std::error_code(-result,
+      std::experimental::net::error::get_system_category());
+
+  // Check if we need to run the operation again.
+  return ec != std::experimental::net::error::interrupted
+    && ec != std::experimental::net::error::would_block
+    && ec != std::experimental::net::error::try_again;
+}
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #endif // defined(NET_TS_HAS_IOCP)
 
 signed_size_type sendto(socket_type s, const buf* bufs, size_t count,
@@ -1373,6 +1522,160 @@ bool non_blocking_sendto(socket_type s,
   }
 }
 
+signed_size_type recvmmsg(socket_type s, mmsg_slot* slots,
+    size_t count, int flags, std::error_code& ec)
+{
+  if (count > max_mmsg_slots)
+    count = max_mmsg_slots;
+
+#if defined(NET_TS_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_mmsg_slots];
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i] = mmsghdr();
+    init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, slots[i].addr);
+    msgs[i].msg_hdr.msg_namelen = static_cast<int>(slots[i].addrlen);
+    msgs[i].msg_hdr.msg_iov = &slots[i].data;
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  signed_size_type result = error_wrapper(::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags, 0), ec);
+  for (signed_size_type i = 0; i < result; ++i)
+  {
+    slots[i].addrlen = msgs[i].msg_hdr.msg_namelen;
+    slots[i].bytes_transferred = msgs[i].msg_len;
+  }
+  if (result >= 0)
+    ec = std::error_code();
+  return result;
+#else // defined(NET_TS_HAS_MMSG)
+  // Receive one datagram at a time. As with recvmmsg(), an error is reported
+  // only if no datagram has been received.
+  signed_size_type result = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    signed_size_type bytes = socket_ops::recvfrom(s, &slots[i].data, 1,
+        flags, slots[i].addr, &slots[i].addrlen, ec);
+    if (bytes < 0)
+      break;
+    slots[i].bytes_transferred = bytes;
+    ++result;
+  }
+  if (result > 0)
+    ec = std::error_code();
+  return result > 0 ? result : (count > 0 ? socket_error_retval : 0);
+#endif // defined(NET_TS_HAS_MMSG)
+}
+
+bool non_blocking_recvmmsg(socket_type s,
+    mmsg_slot* slots, size_t count, int flags,
+    std::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    signed_size_type messages = socket_ops::recvmmsg(
+        s, slots, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == std::experimental::net::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == std::experimental::net::error::would_block
+        || ec == std::experimental::net::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = std::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
+signed_size_type sendmmsg(socket_type s, mmsg_slot* slots,
+    size_t count, int flags, std::error_code& ec)
+{
+  if (count > max_mmsg_slots)
+    count = max_mmsg_slots;
+
+#if defined(NET_TS_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_mmsg_slots];
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i] = mmsghdr();
+    init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, slots[i].addr);
+    msgs[i].msg_hdr.msg_namelen = static_cast<int>(slots[i].addrlen);
+    msgs[i].msg_hdr.msg_iov = &slots[i].data;
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  flags |= MSG_NOSIGNAL;
+  signed_size_type result = error_wrapper(::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags), ec);
+  for (signed_size_type i = 0; i < result; ++i)
+    slots[i].bytes_transferred = msgs[i].msg_len;
+  if (result >= 0)
+    ec = std::error_code();
+  return result;
+#else // defined(NET_TS_HAS_MMSG)
+  // Send one datagram at a time. As with sendmmsg(), an error is reported
+  // only if no datagram has been sent.
+  signed_size_type result = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    signed_size_type bytes = socket_ops::sendto(s, &slots[i].data, 1,
+        flags, slots[i].addr, slots[i].addrlen, ec);
+    if (bytes < 0)
+      break;
+    slots[i].bytes_transferred = bytes;
+    ++result;
+  }
+  if (result > 0)
+    ec = std::error_code();
+  return result > 0 ? result : (count > 0 ? socket_error_retval : 0);
+#endif // defined(NET_TS_HAS_MMSG)
+}
+
+bool non_blocking_sendmmsg(socket_type s,
+    mmsg_slot* slots, size_t count, int flags,
+    std::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    signed_size_type messages = socket_ops::sendmmsg(
+        s, slots, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == std::experimental::net::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == std::experimental::net::error::would_block
+        || ec == std::experimental::net::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = std::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
 #endif // !defined(NET_TS_HAS_IOCP)
 
 socket_type socket(int af, int type, int protocol,
@@ -1413,6 +1716,12 @@ socket_type socket(int af, int type, int protocol,
   }
 
   return s;
+#elif defined(NET_TS_HAS_SOCK_NONBLOCK)
+  int s = error_wrapper(::socket(af,
+        type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol), ec);
+  if (s >= 0)
+    ec = std::error_code();
+  return s;
 #else
   int s = error_wrapper(::socket(af, type, protocol), ec);
   if (s >= 0)
@@ -59,13 +59,7 @@ public:
 
     ~on_invoker_exit()
     {
-      this_->impl_->mutex_->lock();
-      this_->impl_->ready_queue_.push(this_->impl_->waiting_queue_);
-      bool more_handlers = this_->impl_->locked_ =
-        !this_->impl_->ready_queue_.empty();
-      this_->impl_->mutex_->unlock();
-
-      if (more_handlers)
+      if (push_waiting_to_ready(this_->impl_))
       {
         Executor ex(this_->work_.get_executor());
         recycling_allocator<void> allocator;
@@ -83,14 +77,9 @@ public:
     on_invoker_exit on_exit = { this };
     (void)on_exit;
 
-    // Run all ready handlers. No lock is required since the ready queue is
+    // Run the ready handlers. No lock is required since the ready queue is
     // accessed only within the strand.
-    std::error_code ec;
-    while (scheduler_operation* o = impl_->ready_queue_.front())
-    {
-      impl_->ready_queue_.pop();
-      o->complete(impl_.get(), ec, 0);
-    }
+    run_ready_handlers(impl_);
   }
 
 private:
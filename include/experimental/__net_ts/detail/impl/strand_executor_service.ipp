@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/detail/config.hpp>
+#include <experimental/__net_ts/detail/chrono.hpp>
+#include <experimental/__net_ts/detail/scheduler.hpp>
 #include <experimental/__net_ts/detail/strand_executor_service.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
@@ -29,7 +31,9 @@ namespace detail {
 strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
+#if !defined(NET_TS_HAS_STD_ATOMIC)
     salt_(0),
+#endif // !defined(NET_TS_HAS_STD_ATOMIC)
     impl_list_(0)
 {
 }
@@ -43,7 +47,11 @@ void strand_executor_service::shutdown()
   strand_impl* impl = impl_list_;
   while (impl)
   {
+#if defined(NET_TS_HAS_STD_ATOMIC)
+    take_waiting(impl, ops);
+#else // defined(NET_TS_HAS_STD_ATOMIC)
     ops.push(impl->waiting_queue_);
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
     ops.push(impl->ready_queue_);
     impl = impl->next_;
   }
@@ -53,10 +61,20 @@ strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
   implementation_type new_impl(new strand_impl);
+#if defined(NET_TS_HAS_STD_ATOMIC)
+  new_impl->state_.store(0, std::memory_order_relaxed);
+#else // defined(NET_TS_HAS_STD_ATOMIC)
   new_impl->locked_ = false;
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
+  new_impl->max_handlers_ = 0;
+  new_impl->max_usec_ = 0;
+  new_impl->run_inline_ = false;
+  new_impl->scheduler_ = has_service<scheduler>(context())
+    ? &use_service<scheduler>(context()) : 0;
 
   std::experimental::net::detail::mutex::scoped_lock lock(mutex_);
 
+#if !defined(NET_TS_HAS_STD_ATOMIC)
   // Select a mutex from the pool of shared mutexes.
   std::size_t salt = salt_++;
   std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
@@ -66,6 +84,7 @@ strand_executor_service::create_implementation()
   if (!mutexes_[mutex_index].get())
     mutexes_[mutex_index].reset(new mutex);
   new_impl->mutex_ = mutexes_[mutex_index].get();
+#endif // !defined(NET_TS_HAS_STD_ATOMIC)
 
   // Insert implementation into linked list of all implementations.
   new_impl->next_ = impl_list_;
@@ -91,6 +110,82 @@ strand_executor_service::strand_impl::~strand_impl()
     next_->prev_= prev_;
 }
 
+#if defined(NET_TS_HAS_STD_ATOMIC)
+
+bool strand_executor_service::enqueue(const implementation_type& impl,
+    scheduler_operation* op)
+{
+  scheduler_operation* const marker = locked_marker(impl.get());
+  scheduler_operation* state = impl->state_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    if (state == 0)
+    {
+      // The function is acquiring the strand lock and so is responsible for
+      // scheduling the strand.
+      if (impl->state_.compare_exchange_weak(state, marker,
+            std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        impl->ready_queue_.push(op);
+        return true;
+      }
+    }
+    else
+    {
+      // Some other function already holds the strand lock. Enqueue for later.
+      op_queue_access::next(op, state);
+      if (impl->state_.compare_exchange_weak(state, op,
+            std::memory_order_release, std::memory_order_relaxed))
+        return false;
+    }
+  }
+}
+
+bool strand_executor_service::push_waiting_to_ready(
+    implementation_type& impl)
+{
+  scheduler_operation* const marker = locked_marker(impl.get());
+  scheduler_operation* state = marker;
+  if (impl->ready_queue_.empty()
+      && impl->state_.compare_exchange_strong(state, 0,
+        std::memory_order_release, std::memory_order_relaxed))
+    return false;
+
+  take_waiting(impl.get(), impl->ready_queue_);
+  return true;
+}
+
+void strand_executor_service::take_waiting(strand_impl* impl,
+    op_queue<scheduler_operation>& ops)
+{
+  scheduler_operation* const marker = locked_marker(impl);
+  if (impl->state_.load(std::memory_order_relaxed) == 0)
+    return;
+
+  scheduler_operation* top = impl->state_.exchange(
+      marker, std::memory_order_acquire);
+
+  // Reverse the chain so that the handlers are in the order in which they
+  // were enqueued.
+  scheduler_operation* front = 0;
+  while (top != marker && top != 0)
+  {
+    scheduler_operation* next = op_queue_access::next(top);
+    op_queue_access::next(top, front);
+    front = top;
+    top = next;
+  }
+
+  while (front)
+  {
+    scheduler_operation* next = op_queue_access::next(front);
+    ops.push(front);
+    front = next;
+  }
+}
+
+#else // defined(NET_TS_HAS_STD_ATOMIC)
+
 bool strand_executor_service::enqueue(const implementation_type& impl,
     scheduler_operation* op)
 {
@@ -113,12 +208,89 @@ bool strand_executor_service::enqueue(const implementation_type& impl,
   }
 }
 
+bool strand_executor_service::push_waiting_to_ready(
+    implementation_type& impl)
+{
+  impl->mutex_->lock();
+  impl->ready_queue_.push(impl->waiting_queue_);
+  bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
+  impl->mutex_->unlock();
+  return more_handlers;
+}
+
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
+
 bool strand_executor_service::running_in_this_thread(
     const implementation_type& impl)
 {
   return !!call_stack<strand_impl>::contains(impl.get());
 }
 
+void strand_executor_service::set_batching(const implementation_type& impl,
+    std::size_t max_handlers, long max_usec, bool run_inline)
+{
+  impl->max_handlers_ = max_handlers;
+  impl->max_usec_ = max_usec > 0 ? max_usec : 0;
+  impl->run_inline_ = run_inline;
+}
+
+void strand_executor_service::run_ready_handlers(implementation_type& impl)
+{
+  const std::size_t max_handlers = impl->max_handlers_;
+#if defined(NET_TS_HAS_CHRONO)
+  const bool timed = impl->max_usec_ > 0;
+  chrono::steady_clock::time_point deadline;
+  if (timed)
+    deadline = chrono::steady_clock::now()
+      + chrono::microseconds(impl->max_usec_);
+#endif // defined(NET_TS_HAS_CHRONO)
+
+  std::error_code ec;
+  std::size_t n = 0;
+  do
+  {
+    while (scheduler_operation* o = impl->ready_queue_.front())
+    {
+      // Yield once the turn's budget is used up. At least one handler is run
+      // each time the strand is scheduled.
+      if (n > 0)
+      {
+        if (max_handlers && n >= max_handlers)
+          return;
+#if defined(NET_TS_HAS_CHRONO)
+        if (timed && chrono::steady_clock::now() >= deadline)
+          return;
+#endif // defined(NET_TS_HAS_CHRONO)
+      }
+
+      impl->ready_queue_.pop();
+      ++n;
+      o->complete(impl.get(), ec, 0);
+    }
+  } while (impl->run_inline_ && take_waiting_inline(impl));
+}
+
+bool strand_executor_service::take_waiting_inline(implementation_type& impl)
+{
+#if defined(NET_TS_HAS_STD_ATOMIC)
+  if (impl->state_.load(std::memory_order_relaxed) == locked_marker(impl.get()))
+    return false;
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
+
+  if (!impl->scheduler_ || impl->scheduler_->has_pending_handlers())
+    return false;
+
+#if defined(NET_TS_HAS_STD_ATOMIC)
+  take_waiting(impl.get(), impl->ready_queue_);
+#else // defined(NET_TS_HAS_STD_ATOMIC)
+  impl->mutex_->lock();
+  impl->ready_queue_.push(impl->waiting_queue_);
+  impl->mutex_->unlock();
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
+
+  return !impl->ready_queue_.empty();
+}
+
 } // namespace detail
 } // inline namespace v1
 } // namespace net
@@ -37,6 +37,18 @@ timer_queue<time_traits<boost::posix_time::ptime> >::~timer_queue()
 {
 }
 
+void timer_queue<time_traits<boost::posix_time::ptime> >::use_wheel(
+    long resolution_usec, std::size_t slots_per_level, std::size_t levels)
+{
+  impl_.use_wheel(resolution_usec, slots_per_level, levels);
+}
+
+void timer_queue<time_traits<boost::posix_time::ptime> >::set_slack(
+    long slack_usec)
+{
+  impl_.set_slack(slack_usec);
+}
+
 bool timer_queue<time_traits<boost::posix_time::ptime> >::enqueue_timer(
     const time_type& time, per_timer_data& timer, wait_op* op)
 {
@@ -60,10 +72,11 @@ long timer_queue<time_traits<boost::posix_time::ptime> >::wait_duration_usec(
   return impl_.wait_duration_usec(max_duration);
 }
 
-void timer_queue<time_traits<boost::posix_time::ptime> >::get_ready_timers(
+std::size_t
+timer_queue<time_traits<boost::posix_time::ptime> >::get_ready_timers(
     op_queue<operation>& ops)
 {
-  impl_.get_ready_timers(ops);
+  return impl_.get_ready_timers(ops);
 }
 
 void timer_queue<time_traits<boost::posix_time::ptime> >::get_all_timers(
@@ -84,6 +97,12 @@ void timer_queue<time_traits<boost::posix_time::ptime> >::move_timer(
   impl_.move_timer(target, source);
 }
 
+bool timer_queue<time_traits<boost::posix_time::ptime> >::reschedule_timer(
+    per_timer_data& timer, const time_type& time)
+{
+  return impl_.reschedule_timer(timer, time);
+}
+
 } // namespace detail
 } // inline namespace v1
 } // namespace net
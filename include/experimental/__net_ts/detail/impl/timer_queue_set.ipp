@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/detail/config.hpp>
+#include <experimental/__net_ts/detail/thread_context.hpp>
+#include <experimental/__net_ts/detail/thread_info_base.hpp>
 #include <experimental/__net_ts/detail/timer_queue_set.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
@@ -84,10 +86,16 @@ long timer_queue_set::wait_duration_usec(long max_duration) const
   return min_duration;
 }
 
-void timer_queue_set::get_ready_timers(op_queue<operation>& ops)
+std::size_t timer_queue_set::get_ready_timers(op_queue<operation>& ops)
 {
+  // The reactor may have waited since the current thread last read the time.
+  if (thread_info_base* this_thread = thread_context::thread_call_stack::top())
+    this_thread->clear_loop_time();
+
+  std::size_t n = 0;
   for (timer_queue_base* p = first_; p; p = p->next_)
-    p->get_ready_timers(ops);
+    n += p->get_ready_timers(ops);
+  return n;
 }
 
 void timer_queue_set::get_all_timers(op_queue<operation>& ops)
@@ -419,6 +419,9 @@ size_t win_iocp_io_context::do_one(DWORD msec, std::error_code& ec)
         work_finished_on_block_exit on_exit = { this };
         (void)on_exit;
 
+        if (thread_info_base* this_thread = thread_call_stack::top())
+          this_thread->clear_loop_time();
+
         op->complete(this, result_ec, bytes_transferred);
         ec = std::error_code();
         return 1;
@@ -0,0 +1,353 @@
+//
+// detail/io_uring_reactor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_IO_URING_REACTOR_HPP
+#define NET_TS_DETAIL_IO_URING_REACTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include <experimental/__net_ts/detail/conditionally_enabled_mutex.hpp>
+#include <experimental/__net_ts/detail/limits.hpp>
+#include <experimental/__net_ts/detail/object_pool.hpp>
+#include <experimental/__net_ts/detail/op_queue.hpp>
+#include <experimental/__net_ts/detail/reactor_op.hpp>
+#include <experimental/__net_ts/detail/socket_types.hpp>
+#include <experimental/__net_ts/detail/timer_queue_base.hpp>
+#include <experimental/__net_ts/detail/timer_queue_set.hpp>
+#include <experimental/__net_ts/detail/wait_op.hpp>
+#include <experimental/__net_ts/execution_context.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+// A completion-based alternative to the epoll_reactor. Operations that can be
+// expressed as a single io_uring submission (single-buffer send and receive,
+// and accept) are handed to the kernel directly. All other operations are
+// submitted as a one-shot poll for readiness, after which the operation is
+// performed in the same way as with the epoll_reactor.
+class io_uring_reactor
+  : public execution_context_service_base<io_uring_reactor>
+{
+private:
+  // The mutex type used by this reactor.
+  typedef conditionally_enabled_mutex mutex;
+
+public:
+  enum op_types { read_op = 0, write_op = 1,
+    connect_op = 1, except_op = 2, max_ops = 3 };
+
+  class descriptor_state;
+
+  // Per-descriptor queue for a single operation type. Only the operation at
+  // the front of the queue is ever in flight in the kernel, to ensure that
+  // operations of the same type complete in the order they were started.
+  class io_queue : operation
+  {
+    friend class io_uring_reactor;
+
+    descriptor_state* descriptor_data_;
+    int op_type_;
+    op_queue<reactor_op> op_queue_;
+    bool in_flight_;
+    bool polling_;
+    bool cancel_requested_;
+
+    NET_TS_DECL io_queue();
+    void set_result(int result)
+    {
+      task_result_ = static_cast<unsigned>(result);
+    }
+    NET_TS_DECL operation* perform_io(int result);
+    NET_TS_DECL static void do_complete(
+        void* owner, operation* base,
+        const std::error_code& ec, std::size_t bytes_transferred);
+  };
+
+  // Per-descriptor state.
+  class descriptor_state
+  {
+    friend class io_uring_reactor;
+    friend class object_pool_access;
+
+    descriptor_state* next_;
+    descriptor_state* prev_;
+
+    mutex mutex_;
+    io_uring_reactor* reactor_;
+    int descriptor_;
+    io_queue queues_[max_ops];
+    bool shutdown_;
+
+    NET_TS_DECL descriptor_state(bool locking);
+    NET_TS_DECL bool has_in_flight_ops() const;
+  };
+
+  // Per-descriptor data.
+  typedef descriptor_state* per_descriptor_data;
+
+  // Constructor.
+  NET_TS_DECL io_uring_reactor(
+      std::experimental::net::execution_context& ctx);
+
+  // Destructor.
+  NET_TS_DECL ~io_uring_reactor();
+
+  // Destroy all user-defined handler objects owned by the service.
+  NET_TS_DECL void shutdown();
+
+  // Recreate internal descriptors following a fork.
+  NET_TS_DECL void notify_fork(
+      std::experimental::net::execution_context::fork_event fork_ev);
+
+  // Initialise the task.
+  NET_TS_DECL void init_task();
+
+  // Register a socket with the reactor. Returns 0 on success, system error
+  // code on failure.
+  NET_TS_DECL int register_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Register a descriptor with an associated single operation. Returns 0 on
+  // success, system error code on failure.
+  NET_TS_DECL int register_internal_descriptor(
+      int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op);
+
+  // Move descriptor registration from one descriptor_data object to another.
+  NET_TS_DECL void move_descriptor(socket_type descriptor,
+      per_descriptor_data& target_descriptor_data,
+      per_descriptor_data& source_descriptor_data);
+
+  // Change the flags used to register the descriptor. The flags have no
+  // effect with this reactor.
+  int set_registration_flags(socket_type,
+      per_descriptor_data&, int)
+  {
+    return 0;
+  }
+
+  // Post a reactor operation for immediate completion.
+  void post_immediate_completion(reactor_op* op, bool is_continuation)
+  {
+    scheduler_.post_immediate_completion(op, is_continuation);
+  }
+
+  // Start a new operation. The operation is submitted to the kernel, either
+  // directly or as a poll for readiness, unless another operation of the same
+  // type is already in flight for the descriptor.
+  NET_TS_DECL void start_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool is_continuation, bool allow_speculative);
+
+  // Cancel all operations associated with the given descriptor. The
+  // handlers associated with the descriptor will be invoked with the
+  // operation_aborted error.
+  NET_TS_DECL void cancel_ops(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Cancel any operations that are running against the descriptor and remove
+  // its registration from the reactor.
+  NET_TS_DECL void deregister_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool closing);
+
+  // Remote the descriptor's registration from the reactor.
+  NET_TS_DECL void deregister_internal_descriptor(
+      socket_type descriptor, per_descriptor_data& descriptor_data);
+
+  // Add a new timer queue to the reactor.
+  template <typename Time_Traits>
+  void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Remove a timer queue from the reactor.
+  template <typename Time_Traits>
+  void remove_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Schedule a new operation in the given timer queue to expire at the
+  // specified absolute time.
+  template <typename Time_Traits>
+  void schedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op);
+
+  // Cancel the timer operations associated with the given token. Returns the
+  // number of operations that have been posted or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
+
+  // Move the timer operations associated with the given timer.
+  template <typename Time_Traits>
+  void move_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& target,
+      typename timer_queue<Time_Traits>::per_timer_data& source);
+
+  // Change the expiry time of the given timer without cancelling the
+  // operations waiting on it.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
+  // Submit pending entries and wait until interrupted or completions are
+  // ready to be dispatched. Returns the number of events found, counting each
+  // completed entry and each expired timer.
+  NET_TS_DECL std::size_t run(long usec, op_queue<operation>& ops);
+
+  // Interrupt the wait for completions.
+  NET_TS_DECL void interrupt();
+
+private:
+  // The number of entries requested for the submission queue.
+  enum { ring_size = 4096 };
+
+  // Create the io_uring instance and map its rings. Throws an exception if
+  // the instance cannot be created.
+  NET_TS_DECL void do_ring_create();
+
+  // Unmap the rings and close the io_uring file descriptor.
+  NET_TS_DECL void do_ring_destroy();
+
+  // Allocate a new descriptor state object.
+  NET_TS_DECL descriptor_state* allocate_descriptor_state();
+
+  // Free an existing descriptor state object.
+  NET_TS_DECL void free_descriptor_state(descriptor_state* s);
+
+  // Helper function to add a new timer queue.
+  NET_TS_DECL void do_add_timer_queue(timer_queue_base& queue);
+
+  // Helper function to remove a timer queue.
+  NET_TS_DECL void do_remove_timer_queue(timer_queue_base& queue);
+
+  // Called to recalculate and update the timeout. Must be called with the
+  // mutex held.
+  NET_TS_DECL void update_timeout();
+
+  // Fill in an entry for the front operation of a queue, falling back to a
+  // poll for readiness if the operation cannot be submitted directly.
+  NET_TS_DECL void prepare_io(io_queue& q, ::io_uring_sqe& sqe);
+
+  // Fill in an entry that waits for the queue's descriptor to become ready.
+  NET_TS_DECL void prepare_poll(io_queue& q, ::io_uring_sqe& sqe);
+
+  // Submit the prepared entry for the front operation of a queue. Must be
+  // called with the descriptor's mutex held. Returns 0 on success, system
+  // error code on failure.
+  NET_TS_DECL int submit_io(io_queue& q, ::io_uring_sqe& sqe);
+
+  // Submit a request to cancel the in-flight operation of a queue. Must be
+  // called with the descriptor's mutex held.
+  NET_TS_DECL void submit_cancel(io_queue& q);
+
+  // Queue an entry for submission. Must be called with the mutex held.
+  // Returns 0 on success, system error code on failure.
+  NET_TS_DECL int push_sqe(const ::io_uring_sqe& sqe);
+
+  // Hand all queued entries to the kernel. Must be called with the mutex
+  // held. Returns 0 on success, system error code on failure.
+  NET_TS_DECL int flush_sqes();
+
+  // Call io_uring_enter, waiting at most usec microseconds if wait_nr is
+  // non-zero and usec is non-negative.
+  NET_TS_DECL int do_enter(unsigned to_submit,
+      unsigned wait_nr, long usec);
+
+  // Harvest available completion queue entries. Returns the number of
+  // entries that referred to an io_queue.
+  NET_TS_DECL std::size_t reap_cqes(op_queue<operation>* ops,
+      bool& check_timers);
+
+  // The scheduler implementation used to post completions.
+  scheduler& scheduler_;
+
+  // Mutex to protect access to internal data, including the submission queue.
+  mutex mutex_;
+
+  // The io_uring file descriptor.
+  int ring_fd_;
+
+  // The mapped submission and completion queue rings.
+  void* ring_;
+  std::size_t ring_bytes_;
+
+  // The mapped submission queue entries.
+  ::io_uring_sqe* sqes_;
+  std::size_t sqes_bytes_;
+
+  // Pointers into the submission queue ring.
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+
+  // Pointers into the completion queue ring.
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  ::io_uring_cqe* cqes_;
+
+  // The number of entries referring to an io_queue that have been submitted
+  // but whose completions have not yet been harvested.
+  std::size_t outstanding_;
+
+  // Whether a thread is blocked waiting for completions.
+  bool waiting_;
+
+  // Whether the next wait for completions should be skipped.
+  bool interrupted_;
+
+  // The timeout used to wake the reactor when the earliest timer expires.
+  __kernel_timespec timeout_;
+
+  // Whether the timeout entry is in flight in the kernel.
+  bool timeout_pending_;
+
+  // The timer queues.
+  timer_queue_set timer_queues_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
+  // Mutex to protect access to the registered descriptors.
+  mutex registered_descriptors_mutex_;
+
+  // Keep track of all registered descriptors.
+  object_pool<descriptor_state> registered_descriptors_;
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#include <experimental/__net_ts/detail/impl/io_uring_reactor.hpp>
+#if defined(NET_TS_HEADER_ONLY)
+# include <experimental/__net_ts/detail/impl/io_uring_reactor.ipp>
+#endif // defined(NET_TS_HEADER_ONLY)
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
+#endif // NET_TS_DETAIL_IO_URING_REACTOR_HPP
@@ -121,6 +121,34 @@ struct is_executor
 {
 };
 
+struct post_batch_memfn_base
+{
+  void post_batch();
+};
+
+template <typename T>
+struct post_batch_memfn_derived
+  : T, post_batch_memfn_base
+{
+};
+
+template <typename>
+char (&post_batch_memfn_helper(...))[2];
+
+template <typename T>
+char post_batch_memfn_helper(
+    executor_memfns_check<
+      void (post_batch_memfn_base::*)(),
+      &post_batch_memfn_derived<T>::post_batch>*);
+
+// Determines whether an executor provides a post_batch() member function.
+template <typename T>
+struct has_post_batch
+  : integral_constant<bool,
+      sizeof(post_batch_memfn_helper<T>(0)) != 1>
+{
+};
+
 } // namespace detail
 } // inline namespace v1
 } // namespace net
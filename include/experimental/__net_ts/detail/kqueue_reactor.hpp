@@ -116,6 +116,14 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Change the flags used to register the descriptor. The flags have no
+  // effect with this reactor.
+  int set_registration_flags(socket_type,
+      per_descriptor_data&, int)
+  {
+    return 0;
+  }
+
   // Post a reactor operation for immediate completion.
   void post_immediate_completion(reactor_op* op, bool is_continuation)
   {
@@ -171,8 +179,16 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
-  // Run the kqueue loop.
-  NET_TS_DECL void run(long usec, op_queue<operation>& ops);
+  // Change the expiry time of the given timer without cancelling the
+  // operations waiting on it.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
+  // Run the kqueue loop. Returns the number of events found, counting each
+  // ready descriptor and each expired timer.
+  NET_TS_DECL std::size_t run(long usec, op_queue<operation>& ops);
 
   // Interrupt the kqueue loop.
   NET_TS_DECL void interrupt();
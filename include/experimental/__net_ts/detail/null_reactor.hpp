@@ -51,8 +51,9 @@ public:
   }
 
   // No-op because should never be called.
-  void run(long /*usec*/, op_queue<scheduler_operation>& /*ops*/)
+  std::size_t run(long /*usec*/, op_queue<scheduler_operation>& /*ops*/)
   {
+    return 0;
   }
 
   // No-op.
@@ -0,0 +1,209 @@
+//
+// detail/reactive_socket_accept_many_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_REACTIVE_SOCKET_ACCEPT_MANY_OP_HPP
+#define NET_TS_DETAIL_REACTIVE_SOCKET_ACCEPT_MANY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_MOVE)
+
+#include <vector>
+#include <experimental/__net_ts/detail/bind_handler.hpp>
+#include <experimental/__net_ts/detail/fenced_block.hpp>
+#include <experimental/__net_ts/detail/memory.hpp>
+#include <experimental/__net_ts/detail/reactor_op.hpp>
+#include <experimental/__net_ts/detail/socket_access.hpp>
+#include <experimental/__net_ts/detail/socket_ops.hpp>
+#include <experimental/__net_ts/socket_base.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+template <typename Protocol>
+class reactive_socket_accept_many_op_base : public reactor_op
+{
+public:
+  reactive_socket_accept_many_op_base(io_context& ioc, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, func_type complete_func)
+    : reactor_op(&reactive_socket_accept_many_op_base::do_perform,
+        complete_func),
+      io_context_(ioc),
+      socket_(socket),
+      state_(state),
+      protocol_(protocol),
+      max_sockets_(clamp_max_sockets(max_sockets))
+  {
+    // Reserve the space up front so that accepting cannot fail part way.
+    new_sockets_.reserve(max_sockets_);
+  }
+
+  ~reactive_socket_accept_many_op_base()
+  {
+    for (std::size_t i = 0; i < new_sockets_.size(); ++i)
+    {
+      if (new_sockets_[i] != invalid_socket)
+      {
+        std::error_code ec;
+        socket_ops::state_type state = 0;
+        socket_ops::close(new_sockets_[i], state, true, ec);
+      }
+    }
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_accept_many_op_base* o(
+        static_cast<reactive_socket_accept_many_op_base*>(base));
+
+    // Drain the listen queue, up to the maximum number of connections.
+    while (o->new_sockets_.size() < o->max_sockets_)
+    {
+      std::error_code ec;
+      socket_type new_socket = invalid_socket;
+      if (!socket_ops::non_blocking_accept(o->socket_,
+            o->state_, 0, 0, ec, new_socket))
+        return o->new_sockets_.empty() ? not_done : done_and_exhausted;
+
+      if (new_socket == invalid_socket)
+      {
+        // Errors are reported only if no connections have been accepted.
+        // Otherwise they will recur on the next accept.
+        if (o->new_sockets_.empty())
+          o->ec_ = ec;
+
+        NET_TS_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept", ec));
+
+        return done;
+      }
+
+      o->new_sockets_.push_back(new_socket);
+    }
+
+    NET_TS_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept", o->ec_));
+
+    return done;
+  }
+
+  void do_assign(std::vector<typename Protocol::socket>& peers)
+  {
+    peers.reserve(new_sockets_.size());
+    for (std::size_t i = 0; i < new_sockets_.size() && !ec_; ++i)
+    {
+      peers.emplace_back(io_context_);
+      socket_access::assign(peers.back(), protocol_, new_sockets_[i],
+          socket_ops::new_socket_state, ec_);
+      if (!ec_)
+        new_sockets_[i] = invalid_socket;
+      else
+        peers.pop_back();
+    }
+  }
+
+private:
+  // A batch never needs to be larger than the listen queue can be.
+  static std::size_t clamp_max_sockets(std::size_t max_sockets)
+  {
+    const std::size_t limit = socket_base::max_listen_connections;
+    if (max_sockets == 0)
+      return 1;
+    return max_sockets < limit ? max_sockets : limit;
+  }
+
+  io_context& io_context_;
+  socket_type socket_;
+  socket_ops::state_type state_;
+  Protocol protocol_;
+  std::size_t max_sockets_;
+  std::vector<socket_type> new_sockets_;
+};
+
+template <typename Protocol, typename Handler>
+class reactive_socket_accept_many_op :
+  public reactive_socket_accept_many_op_base<Protocol>
+{
+public:
+  NET_TS_DEFINE_HANDLER_PTR(reactive_socket_accept_many_op);
+
+  reactive_socket_accept_many_op(io_context& ioc, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_sockets, Handler& handler)
+    : reactive_socket_accept_many_op_base<Protocol>(ioc, socket, state,
+        protocol, max_sockets, &reactive_socket_accept_many_op::do_complete),
+      handler_(NET_TS_MOVE_CAST(Handler)(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const std::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_accept_many_op* o(
+        static_cast<reactive_socket_accept_many_op*>(base));
+    ptr p = { std::experimental::net::detail::addressof(o->handler_), o, o };
+    handler_work<Handler> w(o->handler_);
+
+    // On success, assign the new connections to socket objects.
+    std::vector<typename Protocol::socket> peers;
+    if (owner)
+      o->do_assign(peers);
+
+    NET_TS_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::move_binder2<Handler,
+      std::error_code, std::vector<typename Protocol::socket> >
+        handler(0, NET_TS_MOVE_CAST(Handler)(o->handler_), o->ec_,
+          NET_TS_MOVE_CAST(std::vector<typename Protocol::socket>)(peers));
+    p.h = std::experimental::net::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      NET_TS_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      NET_TS_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // defined(NET_TS_HAS_MOVE)
+
+#endif // NET_TS_DETAIL_REACTIVE_SOCKET_ACCEPT_MANY_OP_HPP
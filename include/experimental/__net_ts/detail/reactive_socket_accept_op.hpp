@@ -21,6 +21,7 @@
 #include <experimental/__net_ts/detail/fenced_block.hpp>
 #include <experimental/__net_ts/detail/memory.hpp>
 #include <experimental/__net_ts/detail/reactor_op.hpp>
+#include <experimental/__net_ts/detail/socket_access.hpp>
 #include <experimental/__net_ts/detail/socket_holder.hpp>
 #include <experimental/__net_ts/detail/socket_ops.hpp>
 
@@ -47,6 +48,10 @@ public:
       peer_endpoint_(peer_endpoint),
       addrlen_(peer_endpoint ? peer_endpoint->capacity() : 0)
   {
+#if defined(NET_TS_HAS_IO_URING)
+    set_io_uring_funcs(&reactive_socket_accept_op_base::do_prepare,
+        &reactive_socket_accept_op_base::do_process_result);
+#endif // defined(NET_TS_HAS_IO_URING)
   }
 
   static status do_perform(reactor_op* base)
@@ -66,13 +71,43 @@ public:
     return result;
   }
 
+#if defined(NET_TS_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, ::io_uring_sqe& sqe)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    o->io_uring_addrlen_ = static_cast<socklen_t>(o->addrlen_);
+    return socket_ops::prepare_io_uring_accept(sqe, o->socket_, o->state_,
+        o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
+        &o->io_uring_addrlen_);
+  }
+
+  static status do_process_result(reactor_op* base, int io_result)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    socket_type new_socket = invalid_socket;
+    status result = socket_ops::complete_io_uring_accept(o->state_,
+        io_result, o->ec_, new_socket) ? done : not_done;
+    o->new_socket_.reset(new_socket);
+    o->addrlen_ = o->io_uring_addrlen_;
+
+    NET_TS_HANDLER_REACTOR_OPERATION((*o, "complete_io_uring_accept", o->ec_));
+
+    return result;
+  }
+#endif // defined(NET_TS_HAS_IO_URING)
+
   void do_assign()
   {
     if (new_socket_.get() != invalid_socket)
     {
       if (peer_endpoint_)
         peer_endpoint_->resize(addrlen_);
-      peer_.assign(protocol_, new_socket_.get(), ec_);
+      socket_access::assign(peer_, protocol_, new_socket_.get(),
+          socket_ops::new_socket_state, ec_);
       if (!ec_)
         new_socket_.release();
     }
@@ -86,6 +121,9 @@ private:
   Protocol protocol_;
   typename Protocol::endpoint* peer_endpoint_;
   std::size_t addrlen_;
+#if defined(NET_TS_HAS_IO_URING)
+  socklen_t io_uring_addrlen_;
+#endif // defined(NET_TS_HAS_IO_URING)
 };
 
 template <typename Socket, typename Protocol, typename Handler>
@@ -44,6 +44,10 @@ public:
       buffers_(buffers),
       flags_(flags)
   {
+#if defined(NET_TS_HAS_IO_URING)
+    set_io_uring_funcs(&reactive_socket_recv_op_base::do_prepare,
+        &reactive_socket_recv_op_base::do_process_result);
+#endif // defined(NET_TS_HAS_IO_URING)
   }
 
   static status do_perform(reactor_op* base)
@@ -70,6 +74,35 @@ public:
     return result;
   }
 
+#if defined(NET_TS_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, ::io_uring_sqe& sqe)
+  {
+    reactive_socket_recv_op_base* o(
+        static_cast<reactive_socket_recv_op_base*>(base));
+
+    buffer_sequence_adapter<std::experimental::net::mutable_buffer,
+        MutableBufferSequence> bufs(o->buffers_);
+
+    return socket_ops::prepare_io_uring_recv(sqe, o->socket_,
+        o->state_, bufs.buffers(), bufs.count(), o->flags_);
+  }
+
+  static status do_process_result(reactor_op* base, int io_result)
+  {
+    reactive_socket_recv_op_base* o(
+        static_cast<reactive_socket_recv_op_base*>(base));
+
+    status result = socket_ops::complete_io_uring_recv(io_result,
+        (o->state_ & socket_ops::stream_oriented) != 0,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    NET_TS_HANDLER_REACTOR_OPERATION((*o, "complete_io_uring_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+#endif // defined(NET_TS_HAS_IO_URING)
+
 private:
   socket_type socket_;
   socket_ops::state_type state_;
@@ -0,0 +1,172 @@
+//
+// detail/reactive_socket_recvmmsg_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_REACTIVE_SOCKET_RECVMMSG_OP_HPP
+#define NET_TS_DETAIL_REACTIVE_SOCKET_RECVMMSG_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <experimental/__net_ts/detail/bind_handler.hpp>
+#include <experimental/__net_ts/detail/fenced_block.hpp>
+#include <experimental/__net_ts/detail/memory.hpp>
+#include <experimental/__net_ts/detail/reactor_op.hpp>
+#include <experimental/__net_ts/detail/socket_ops.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+template <typename Slot>
+class reactive_socket_recvmmsg_op_base : public reactor_op
+{
+public:
+  reactive_socket_recvmmsg_op_base(socket_type socket, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      func_type complete_func)
+    : reactor_op(&reactive_socket_recvmmsg_op_base::do_perform, complete_func),
+      socket_(socket),
+      slots_(slots),
+      count_(count),
+      flags_(flags)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recvmmsg_op_base* o(
+        static_cast<reactive_socket_recvmmsg_op_base*>(base));
+
+    // Receive datagrams until the queue is empty or every slot is filled.
+    std::size_t received = 0;
+    while (received < o->count_)
+    {
+      socket_ops::mmsg_slot slots[socket_ops::max_mmsg_slots];
+      std::size_t n = o->count_ - received;
+      if (n > socket_ops::max_mmsg_slots)
+        n = socket_ops::max_mmsg_slots;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        Slot& slot = o->slots_[received + i];
+        socket_ops::init_buf(slots[i].data,
+            slot.buffer.data(), slot.buffer.size());
+        slots[i].addr = slot.endpoint.data();
+        slots[i].addrlen = slot.endpoint.capacity();
+        slots[i].bytes_transferred = 0;
+      }
+
+      std::size_t messages = 0;
+      if (!socket_ops::non_blocking_recvmmsg(o->socket_,
+            slots, n, o->flags_, o->ec_, messages))
+      {
+        if (received == 0)
+          return not_done;
+        break;
+      }
+
+      for (std::size_t i = 0; i < messages; ++i)
+      {
+        Slot& slot = o->slots_[received + i];
+        slot.endpoint.resize(slots[i].addrlen);
+        slot.size = slots[i].bytes_transferred;
+      }
+      received += messages;
+
+      if (o->ec_ || messages < n)
+        break;
+    }
+
+    // An error is reported only if no datagram has been received. Otherwise
+    // it will recur on the next receive.
+    if (received > 0)
+      o->ec_ = std::error_code();
+    o->bytes_transferred_ = received;
+
+    NET_TS_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recvmmsg",
+          o->ec_, o->bytes_transferred_));
+
+    return done;
+  }
+
+private:
+  socket_type socket_;
+  Slot* slots_;
+  std::size_t count_;
+  socket_base::message_flags flags_;
+};
+
+template <typename Slot, typename Handler>
+class reactive_socket_recvmmsg_op :
+  public reactive_socket_recvmmsg_op_base<Slot>
+{
+public:
+  NET_TS_DEFINE_HANDLER_PTR(reactive_socket_recvmmsg_op);
+
+  reactive_socket_recvmmsg_op(socket_type socket, Slot* slots,
+      std::size_t count, socket_base::message_flags flags, Handler& handler)
+    : reactive_socket_recvmmsg_op_base<Slot>(socket, slots, count, flags,
+        &reactive_socket_recvmmsg_op::do_complete),
+      handler_(NET_TS_MOVE_CAST(Handler)(handler))
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const std::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_recvmmsg_op* o(
+        static_cast<reactive_socket_recvmmsg_op*>(base));
+    ptr p = { std::experimental::net::detail::addressof(o->handler_), o, o };
+    handler_work<Handler> w(o->handler_);
+
+    NET_TS_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, std::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = std::experimental::net::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      NET_TS_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      NET_TS_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_DETAIL_REACTIVE_SOCKET_RECVMMSG_OP_HPP
@@ -27,13 +27,17 @@
 #include <experimental/__net_ts/detail/memory.hpp>
 #include <experimental/__net_ts/detail/noncopyable.hpp>
 #include <experimental/__net_ts/detail/reactive_null_buffers_op.hpp>
+#include <experimental/__net_ts/detail/reactive_socket_accept_many_op.hpp>
 #include <experimental/__net_ts/detail/reactive_socket_accept_op.hpp>
 #include <experimental/__net_ts/detail/reactive_socket_connect_op.hpp>
 #include <experimental/__net_ts/detail/reactive_socket_recvfrom_op.hpp>
+#include <experimental/__net_ts/detail/reactive_socket_recvmmsg_op.hpp>
+#include <experimental/__net_ts/detail/reactive_socket_sendmmsg_op.hpp>
 #include <experimental/__net_ts/detail/reactive_socket_sendto_op.hpp>
 #include <experimental/__net_ts/detail/reactive_socket_service_base.hpp>
 #include <experimental/__net_ts/detail/reactor.hpp>
 #include <experimental/__net_ts/detail/reactor_op.hpp>
+#include <experimental/__net_ts/detail/socket_access.hpp>
 #include <experimental/__net_ts/detail/socket_holder.hpp>
 #include <experimental/__net_ts/detail/socket_ops.hpp>
 #include <experimental/__net_ts/detail/socket_types.hpp>
@@ -136,7 +140,19 @@ public:
       const protocol_type& protocol, const native_handle_type& native_socket,
       std::error_code& ec)
   {
-    if (!do_assign(impl, protocol.type(), native_socket, ec))
+    if (!do_assign(impl, protocol.type(),
+          native_socket, socket_ops::possible_dup, ec))
+      impl.protocol_ = protocol;
+    return ec;
+  }
+
+  // Assign a native socket whose state is known, such as a newly accepted
+  // connection, to a socket implementation.
+  std::error_code assign(implementation_type& impl,
+      const protocol_type& protocol, const native_handle_type& native_socket,
+      socket_ops::state_type state, std::error_code& ec)
+  {
+    if (!do_assign(impl, protocol.type(), native_socket, state, ec))
       impl.protocol_ = protocol;
     return ec;
   }
@@ -379,6 +395,55 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous send of a batch of datagrams. The slots and the
+  // buffers they refer to must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Slot, typename Handler>
+  void async_send_batch(implementation_type& impl, Slot* slots,
+      std::size_t count, socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      networking_ts_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<Slot, Handler> op;
+    typename op::ptr p = { std::experimental::net::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, slots, count, flags, handler);
+
+    NET_TS_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_batch"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. The slots and the
+  // buffers they refer to must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Slot, typename Handler>
+  void async_receive_batch(implementation_type& impl, Slot* slots,
+      std::size_t count, socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      networking_ts_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<Slot, Handler> op;
+    typename op::ptr p = { std::experimental::net::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, slots, count, flags, handler);
+
+    NET_TS_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_batch"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+
   // Accept a new connection.
   template <typename Socket>
   std::error_code accept(implementation_type& impl,
@@ -401,7 +466,8 @@ public:
     {
       if (peer_endpoint)
         peer_endpoint->resize(addr_len);
-      peer.assign(impl.protocol_, new_socket.get(), ec);
+      socket_access::assign(peer, impl.protocol_, new_socket.get(),
+          socket_ops::new_socket_state, ec);
       if (!ec)
         new_socket.release();
     }
@@ -428,7 +494,8 @@ public:
     {
       if (peer_endpoint)
         peer_endpoint->resize(addr_len);
-      peer.assign(impl.protocol_, new_socket.get(), ec);
+      socket_access::assign(peer, impl.protocol_, new_socket.get(),
+          socket_ops::new_socket_state, ec);
       if (!ec)
         new_socket.release();
     }
@@ -484,6 +551,29 @@ public:
     start_accept_op(impl, p.p, is_continuation, false);
     p.v = p.p = 0;
   }
+
+  // Start an asynchronous accept of up to max_sockets connections.
+  template <typename Handler>
+  void async_accept_many(implementation_type& impl,
+      std::experimental::net::io_context* peer_io_context,
+      std::size_t max_sockets, Handler& handler)
+  {
+    bool is_continuation =
+      networking_ts_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_accept_many_op<Protocol, Handler> op;
+    typename op::ptr p = { std::experimental::net::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(peer_io_context ? *peer_io_context : io_context_,
+        impl.socket_, impl.state_, impl.protocol_, max_sockets, handler);
+
+    NET_TS_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_accept_many"));
+
+    start_accept_op(impl, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
 #endif // defined(NET_TS_HAS_MOVE)
 
   // Connect the socket to the specified endpoint.
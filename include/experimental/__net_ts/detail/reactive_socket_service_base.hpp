@@ -106,6 +106,10 @@ public:
   NET_TS_DECL std::error_code cancel(
       base_implementation_type& impl, std::error_code& ec);
 
+  // Change the flags used to register the socket with the reactor.
+  NET_TS_DECL std::error_code set_registration_flags(
+      base_implementation_type& impl, int flags, std::error_code& ec);
+
   // Determine whether the socket is at the out-of-band data mark.
   bool at_mark(const base_implementation_type& impl,
       std::error_code& ec) const
@@ -259,7 +263,8 @@ public:
   template <typename ConstBufferSequence, typename Handler>
   void async_send(base_implementation_type& impl,
       const ConstBufferSequence& buffers,
-      socket_base::message_flags flags, Handler& handler)
+      socket_base::message_flags flags, Handler& handler,
+      int64_t deadline = 0)
   {
     bool is_continuation =
       networking_ts_handler_cont_helpers::is_continuation(handler);
@@ -269,6 +274,7 @@ public:
     typename op::ptr p = { std::experimental::net::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(impl.socket_, impl.state_, buffers, flags, handler);
+    p.p->deadline_ = deadline;
 
     NET_TS_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send"));
@@ -329,7 +335,8 @@ public:
   template <typename MutableBufferSequence, typename Handler>
   void async_receive(base_implementation_type& impl,
       const MutableBufferSequence& buffers,
-      socket_base::message_flags flags, Handler& handler)
+      socket_base::message_flags flags, Handler& handler,
+      int64_t deadline = 0)
   {
     bool is_continuation =
       networking_ts_handler_cont_helpers::is_continuation(handler);
@@ -339,6 +346,7 @@ public:
     typename op::ptr p = { std::experimental::net::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(impl.socket_, impl.state_, buffers, flags, handler);
+    p.p->deadline_ = deadline;
 
     NET_TS_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive"));
@@ -470,10 +478,12 @@ protected:
       base_implementation_type& impl, int af,
       int type, int protocol, std::error_code& ec);
 
-  // Assign a native socket to a socket implementation.
+  // Assign a native socket to a socket implementation. The state gives the
+  // known state of the native socket.
   NET_TS_DECL std::error_code do_assign(
       base_implementation_type& impl, int type,
-      const native_handle_type& native_socket, std::error_code& ec);
+      const native_handle_type& native_socket,
+      socket_ops::state_type state, std::error_code& ec);
 
   // Start the asynchronous read or write operation.
   NET_TS_DECL void start_op(base_implementation_type& impl, int op_type,
@@ -17,7 +17,9 @@
 
 #include <experimental/__net_ts/detail/reactor_fwd.hpp>
 
-#if defined(NET_TS_HAS_EPOLL)
+#if defined(NET_TS_HAS_IO_URING)
+# include <experimental/__net_ts/detail/io_uring_reactor.hpp>
+#elif defined(NET_TS_HAS_EPOLL)
 # include <experimental/__net_ts/detail/epoll_reactor.hpp>
 #elif defined(NET_TS_HAS_KQUEUE)
 # include <experimental/__net_ts/detail/kqueue_reactor.hpp>
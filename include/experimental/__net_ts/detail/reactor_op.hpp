@@ -16,8 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/detail/config.hpp>
+#include <experimental/__net_ts/detail/cstdint.hpp>
 #include <experimental/__net_ts/detail/operation.hpp>
 
+#if defined(NET_TS_HAS_IO_URING)
+# include <linux/io_uring.h>
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #include <experimental/__net_ts/detail/push_options.hpp>
 
 namespace std {
@@ -36,6 +41,10 @@ public:
   // The number of bytes transferred, to be passed to the completion handler.
   std::size_t bytes_transferred_;
 
+  // The time, in nanoseconds of the steady clock, after which the operation
+  // is completed with the timed_out error. Zero if there is no deadline.
+  int64_t deadline_;
+
   // Status returned by perform function. May be used to decide whether it is
   // worth performing more operations on the descriptor immediately.
   enum status { not_done, done, done_and_exhausted };
@@ -46,18 +55,56 @@ public:
     return perform_func_(this);
   }
 
+#if defined(NET_TS_HAS_IO_URING)
+  // Prepare a submission queue entry that performs the operation directly.
+  // Returns false if the operation must instead wait for readiness and then
+  // be performed using perform().
+  bool prepare(::io_uring_sqe& sqe)
+  {
+    return prepare_func_ ? prepare_func_(this, sqe) : false;
+  }
+
+  // Process the result of a submission queue entry prepared by prepare().
+  status process_result(int result)
+  {
+    return result_func_(this, result);
+  }
+#endif // defined(NET_TS_HAS_IO_URING)
+
 protected:
   typedef status (*perform_func_type)(reactor_op*);
 
   reactor_op(perform_func_type perform_func, func_type complete_func)
     : operation(complete_func),
       bytes_transferred_(0),
+      deadline_(0),
       perform_func_(perform_func)
+#if defined(NET_TS_HAS_IO_URING)
+      , prepare_func_(0),
+      result_func_(0)
+#endif // defined(NET_TS_HAS_IO_URING)
+  {
+  }
+
+#if defined(NET_TS_HAS_IO_URING)
+  typedef bool (*prepare_func_type)(reactor_op*, ::io_uring_sqe&);
+  typedef status (*result_func_type)(reactor_op*, int);
+
+  // Allow the operation to be submitted directly to an io_uring instance.
+  void set_io_uring_funcs(prepare_func_type prepare_func,
+      result_func_type result_func)
   {
+    prepare_func_ = prepare_func;
+    result_func_ = result_func;
   }
+#endif // defined(NET_TS_HAS_IO_URING)
 
 private:
   perform_func_type perform_func_;
+#if defined(NET_TS_HAS_IO_URING)
+  prepare_func_type prepare_func_;
+  result_func_type result_func_;
+#endif // defined(NET_TS_HAS_IO_URING)
 };
 
 } // namespace detail
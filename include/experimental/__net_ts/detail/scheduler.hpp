@@ -19,7 +19,9 @@
 
 #include <system_error>
 #include <experimental/__net_ts/execution_context.hpp>
+#include <experimental/__net_ts/io_context_statistics.hpp>
 #include <experimental/__net_ts/detail/atomic_count.hpp>
+#include <experimental/__net_ts/detail/atomic_op_queue.hpp>
 #include <experimental/__net_ts/detail/conditionally_enabled_event.hpp>
 #include <experimental/__net_ts/detail/conditionally_enabled_mutex.hpp>
 #include <experimental/__net_ts/detail/op_queue.hpp>
@@ -27,6 +29,10 @@
 #include <experimental/__net_ts/detail/scheduler_operation.hpp>
 #include <experimental/__net_ts/detail/thread_context.hpp>
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+# include <experimental/__net_ts/detail/scheduler_thread_info.hpp>
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
 #include <experimental/__net_ts/detail/push_options.hpp>
 
 namespace std {
@@ -35,6 +41,7 @@ namespace net {
 inline namespace v1 {
 namespace detail {
 
+struct scheduler_local_queue;
 struct scheduler_thread_info;
 
 class scheduler
@@ -44,11 +51,19 @@ class scheduler
 public:
   typedef scheduler_operation operation;
 
+  // The queues to which operations may be posted, in the order in which they
+  // are serviced.
+  enum priority { high_priority = 0, normal_priority = 1,
+    background_priority = 2 };
+
   // Constructor. Specifies the number of concurrent threads that are likely to
   // run the scheduler. If set to 1 certain optimisation are performed.
   NET_TS_DECL scheduler(std::experimental::net::execution_context& ctx,
       int concurrency_hint = 0);
 
+  // Destructor.
+  NET_TS_DECL ~scheduler();
+
   // Destroy all user-defined handler objects owned by the service.
   NET_TS_DECL void shutdown();
 
@@ -108,6 +123,18 @@ public:
   NET_TS_DECL void post_immediate_completion(
       operation* op, bool is_continuation);
 
+  // Request invocation of the given operations and return immediately.
+  // Assumes that work_started() has not yet been called for the operations,
+  // of which there are n.
+  NET_TS_DECL void post_immediate_completions(std::size_t n,
+      op_queue<operation>& ops, bool is_continuation);
+
+  // Request invocation of the given operation, using the queue for the
+  // specified priority, and return immediately. Assumes that work_started()
+  // has not yet been called for the operation.
+  NET_TS_DECL void post_priority_completion(operation* op,
+      int priority, bool is_continuation);
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   NET_TS_DECL void post_deferred_completion(operation* op);
@@ -130,6 +157,22 @@ public:
     return concurrency_hint_;
   }
 
+  // Set how long a thread that runs out of work keeps polling for new work
+  // before it blocks.
+  NET_TS_DECL void set_idle_spin(long usec);
+
+  // Set whether threads never block, and always run the task without a
+  // timeout. While enabled, this overrides the idle spin setting, which takes
+  // effect again when full polling is disabled.
+  NET_TS_DECL void set_full_polling(bool enable);
+
+  // Take a snapshot of the scheduler's statistics.
+  NET_TS_DECL void get_statistics(io_context_statistics& s);
+
+  // Determine whether there are any handlers, other than the one currently
+  // running on the calling thread, ready to be run.
+  NET_TS_DECL bool has_pending_handlers();
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -152,6 +195,22 @@ private:
   NET_TS_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const std::error_code& ec);
 
+  // Get the queue from which the next operation should be run. Must be called
+  // with the mutex held.
+  NET_TS_DECL op_queue<operation>& ready_queue();
+
+  // Remove the operation at the front of a queue returned by ready_queue().
+  // Must be called with the mutex held.
+  NET_TS_DECL operation* pop_ready(op_queue<operation>& q);
+
+  // Whether there are any operations ready to run. Must be called with the
+  // mutex held.
+  bool has_ready_ops() const
+  {
+    return !op_queue_.empty() || !high_op_queue_.empty()
+      || !background_op_queue_.empty();
+  }
+
   // Stop the task and all idle threads.
   NET_TS_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -159,6 +218,64 @@ private:
   NET_TS_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // Push an operation posted by a thread that is not running the scheduler
+  // on to the injection queue, waking a parked thread if there is one.
+  // Returns false if the operation must instead be queued under the mutex.
+  NET_TS_DECL bool inject(operation* op);
+
+  // Whether any operations are waiting on the injection queue. May be called
+  // without the mutex held.
+  NET_TS_DECL bool has_injected_ops() const;
+
+  // Move any injected operations to the operation queue. Must be called with
+  // the mutex held.
+  NET_TS_DECL void drain_injected();
+
+  // Count the operations on a queue, other than the task operation.
+  NET_TS_DECL std::size_t count_handlers(op_queue<operation>& ops);
+
+  // Mark the calling thread as blocked in the task. Returns false if
+  // operations have been injected since the queue was last drained, in which
+  // case the task should be polled rather than blocked on.
+  NET_TS_DECL bool park_task();
+
+  // Clear the mark set by park_task().
+  NET_TS_DECL void unpark_task();
+
+  // Helper class to decide whether an idle thread should keep spinning.
+  struct idle_spinner;
+
+  // Wait for work, either by spinning or by blocking on the wakeup event.
+  // Must be called with the mutex held.
+  NET_TS_DECL void wait_for_work(mutex::scoped_lock& lock,
+      idle_spinner& spinner);
+
+  // Block on the wakeup event for at most usec microseconds, or indefinitely
+  // if usec is negative, unless operations have been injected. Must be called
+  // with the mutex held.
+  NET_TS_DECL void wait_on_event(mutex::scoped_lock& lock, long usec);
+
+#if defined(NET_TS_HAS_THREADS)
+  // Run at most one operation from the calling thread's local queue. Does not
+  // block, and does not lock the scheduler's mutex.
+  NET_TS_DECL std::size_t do_run_local_one(
+      thread_info& this_thread, const std::error_code& ec);
+
+  // Add operations to the calling thread's local queue, waking an idle thread
+  // so that it may steal them. Assumes that work_started() was previously
+  // called for each operation.
+  NET_TS_DECL void push_local(thread_info& this_thread,
+      op_queue<operation>& ops);
+
+  // Move work from a peer's local queue to the calling thread's local queue.
+  // Must be called with the scheduler's mutex held.
+  NET_TS_DECL bool steal_work(thread_info& this_thread);
+
+  // Helper class to add and remove a thread's local queue.
+  struct local_queue_registration;
+  friend struct local_queue_registration;
+#endif // defined(NET_TS_HAS_THREADS)
+
   // Helper class to perform task-related operations on block exit.
   struct task_cleanup;
   friend struct task_cleanup;
@@ -167,6 +284,15 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to record the time spent by a thread in its statistics.
+  struct statistics_timer;
+
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  // Helper class to claim and release a thread's statistics counters.
+  struct statistics_registration;
+  friend struct statistics_registration;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -194,6 +320,32 @@ private:
   // The queue of handlers that are ready to be delivered.
   op_queue<operation> op_queue_;
 
+  // Handlers posted with high priority. These are run ahead of the handlers
+  // in op_queue_, but in bursts of bounded length so that the task is not
+  // starved.
+  op_queue<operation> high_op_queue_;
+
+  // Handlers posted with background priority. These are run only when
+  // op_queue_ is empty or has the task at its front, alternating with the
+  // task.
+  op_queue<operation> background_op_queue_;
+
+  // The number of high priority handlers that have been run since the last
+  // operation of any other priority.
+  std::size_t high_priority_burst_;
+
+  // Whether a background handler has been run since the task was last run.
+  bool task_due_;
+
+  // The number of handlers on op_queue_, high_op_queue_ and
+  // background_op_queue_, not counting the task operation. Protected by the
+  // mutex.
+  std::size_t shared_handlers_;
+
+  // The number of operations in high_op_queue_. Threads with a local queue
+  // check this before running handlers from it.
+  atomic_count high_priority_ops_;
+
   // Flag to indicate that the dispatcher has been stopped.
   bool stopped_;
 
@@ -202,6 +354,45 @@ private:
 
   // The concurrency hint used to initialise the scheduler.
   const int concurrency_hint_;
+
+  // Whether threads running the scheduler have local queues that may be
+  // stolen from by idle peers.
+  const bool work_stealing_;
+
+  // The local queues of all threads currently running the scheduler.
+  scheduler_local_queue* local_queues_;
+
+  // The number of threads that have run out of work and are about to block.
+  atomic_count idle_threads_;
+
+  // How long idle threads spin before blocking, in microseconds.
+  long idle_spin_usec_;
+
+  // Whether idle threads never block. Protected by the mutex.
+  bool full_polling_;
+
+  // The number of threads spinning on the operation queue. Protected by the
+  // mutex.
+  std::size_t spinning_threads_;
+
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  // Every set of statistics counters that has been claimed by a thread
+  // running the scheduler. Sets are only ever added to the front of the list,
+  // and are not freed until the scheduler is destroyed.
+  std::atomic<scheduler_thread_statistics*> thread_statistics_;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  // Operations posted by threads that are not running the scheduler. These
+  // are moved to the operation queue by the threads running the scheduler.
+  atomic_op_queue<operation> injected_ops_;
+
+  // Whether a thread is blocked in the task.
+  std::atomic<bool> task_parked_;
+
+  // The number of threads blocked on the wakeup event.
+  std::atomic<long> event_waiters_;
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
 };
 
 } // namespace detail
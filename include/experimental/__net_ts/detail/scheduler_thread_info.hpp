@@ -15,9 +15,17 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <experimental/__net_ts/detail/config.hpp>
+#include <cstddef>
+#include <experimental/__net_ts/detail/mutex.hpp>
 #include <experimental/__net_ts/detail/op_queue.hpp>
 #include <experimental/__net_ts/detail/thread_info_base.hpp>
 
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+# include <atomic>
+# include <experimental/__net_ts/detail/cstdint.hpp>
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
 #include <experimental/__net_ts/detail/push_options.hpp>
 
 namespace std {
@@ -29,10 +37,72 @@ namespace detail {
 class scheduler;
 class scheduler_operation;
 
+// Run queue owned by a single thread when the scheduler performs work
+// stealing. The owning thread pushes and pops under the queue's own mutex,
+// while peers may steal from it while holding the scheduler's mutex.
+struct scheduler_local_queue
+{
+  scheduler_local_queue()
+    : size(0),
+      stopped(false),
+      prev(0),
+      next(0)
+  {
+  }
+
+  mutex mutex_;
+  op_queue<scheduler_operation> ops;
+  std::size_t size;
+  bool stopped;
+  scheduler_local_queue* prev;
+  scheduler_local_queue* next;
+};
+
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+// Statistics counters used by one thread at a time. A thread claims a set of
+// counters when it starts running the scheduler and releases it when it
+// stops, and only the claiming thread updates them, so no read-modify-write
+// operations are needed. The counters live as long as the scheduler, and may
+// be read by any thread.
+struct scheduler_thread_statistics
+{
+  typedef std::atomic<uint64_t> counter;
+
+  scheduler_thread_statistics()
+    : handlers(0),
+      task_runs(0),
+      task_events(0),
+      blocked_ns(0),
+      running_ns(0),
+      claimed(false),
+      next(0)
+  {
+  }
+
+  static void add(counter& c, uint64_t n)
+  {
+    c.store(c.load(std::memory_order_relaxed) + n,
+        std::memory_order_relaxed);
+  }
+
+  counter handlers;
+  counter task_runs;
+  counter task_events;
+  counter blocked_ns;
+  counter running_ns;
+  std::atomic<bool> claimed;
+  scheduler_thread_statistics* next;
+};
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+
 struct scheduler_thread_info : public thread_info_base
 {
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+  scheduler_local_queue* local_queue;
+#if defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
+  scheduler_thread_statistics* statistics;
+#endif // defined(NET_TS_HAS_IO_CONTEXT_STATISTICS)
 };
 
 } // namespace detail
@@ -122,6 +122,14 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Change the flags used to register the descriptor. The flags have no
+  // effect with this reactor.
+  int set_registration_flags(socket_type,
+      per_descriptor_data&, int)
+  {
+    return 0;
+  }
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& queue);
@@ -150,8 +158,17 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Change the expiry time of the given timer without cancelling the
+  // operations waiting on it.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Run select once until interrupted or events are ready to be dispatched.
-  NET_TS_DECL void run(long usec, op_queue<operation>& ops);
+  // Returns the number of events found, counting each ready descriptor and
+  // each expired timer.
+  NET_TS_DECL std::size_t run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   NET_TS_DECL void interrupt();
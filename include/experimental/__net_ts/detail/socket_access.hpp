@@ -0,0 +1,55 @@
+//
+// detail/socket_access.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_DETAIL_SOCKET_ACCESS_HPP
+#define NET_TS_DETAIL_SOCKET_ACCESS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <system_error>
+#include <experimental/__net_ts/detail/socket_ops.hpp>
+#include <experimental/__net_ts/detail/socket_types.hpp>
+#include <experimental/__net_ts/ts/netfwd.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+// Gives the socket services access to a socket's implementation, so that a
+// newly accepted connection can be assigned together with its known state.
+class socket_access
+{
+public:
+  template <typename Protocol1, typename Protocol>
+  static std::error_code assign(basic_socket<Protocol1>& peer,
+      const Protocol& protocol, socket_type native_socket,
+      socket_ops::state_type state, std::error_code& ec)
+  {
+    return peer.get_service().assign(peer.get_implementation(),
+        protocol, native_socket, state, ec);
+  }
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_DETAIL_SOCKET_ACCESS_HPP
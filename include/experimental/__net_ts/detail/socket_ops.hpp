@@ -60,6 +60,16 @@ enum
 
 typedef unsigned char state_type;
 
+#if defined(NET_TS_HAS_SOCK_NONBLOCK)
+// The state of a socket created by socket() or accept(). Such sockets are
+// created in non-blocking mode, so no further call is needed to make them
+// non-blocking when they are first used asynchronously.
+const state_type new_socket_state = internal_non_blocking;
+#else // defined(NET_TS_HAS_SOCK_NONBLOCK)
+// The state of a socket created by socket() or accept().
+const state_type new_socket_state = 0;
+#endif // defined(NET_TS_HAS_SOCK_NONBLOCK)
+
 struct noop_deleter { void operator()(void*) {} };
 typedef shared_ptr<void> shared_cancel_token_type;
 typedef weak_ptr<void> weak_cancel_token_type;
@@ -86,6 +96,17 @@ NET_TS_DECL bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
     std::error_code& ec, socket_type& new_socket);
 
+#if defined(NET_TS_HAS_IO_URING)
+
+NET_TS_DECL bool prepare_io_uring_accept(::io_uring_sqe& sqe,
+    socket_type s, state_type state, socket_addr_type* addr,
+    socklen_t* addrlen);
+
+NET_TS_DECL bool complete_io_uring_accept(state_type state, int result,
+    std::error_code& ec, socket_type& new_socket);
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #endif // defined(NET_TS_HAS_IOCP)
 
 NET_TS_DECL int bind(socket_type s, const socket_addr_type* addr,
@@ -157,6 +178,16 @@ NET_TS_DECL bool non_blocking_recv(socket_type s,
     buf* bufs, size_t count, int flags, bool is_stream,
     std::error_code& ec, size_t& bytes_transferred);
 
+#if defined(NET_TS_HAS_IO_URING)
+
+NET_TS_DECL bool prepare_io_uring_recv(::io_uring_sqe& sqe, socket_type s,
+    state_type state, buf* bufs, size_t count, int flags);
+
+NET_TS_DECL bool complete_io_uring_recv(int result, bool is_stream,
+    std::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #endif // defined(NET_TS_HAS_IOCP)
 
 NET_TS_DECL signed_size_type recvfrom(socket_type s, buf* bufs,
@@ -223,6 +254,16 @@ NET_TS_DECL bool non_blocking_send(socket_type s,
     const buf* bufs, size_t count, int flags,
     std::error_code& ec, size_t& bytes_transferred);
 
+#if defined(NET_TS_HAS_IO_URING)
+
+NET_TS_DECL bool prepare_io_uring_send(::io_uring_sqe& sqe, socket_type s,
+    state_type state, const buf* bufs, size_t count, int flags);
+
+NET_TS_DECL bool complete_io_uring_send(int result,
+    std::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(NET_TS_HAS_IO_URING)
+
 #endif // defined(NET_TS_HAS_IOCP)
 
 NET_TS_DECL signed_size_type sendto(socket_type s, const buf* bufs,
@@ -240,6 +281,32 @@ NET_TS_DECL bool non_blocking_sendto(socket_type s,
     const socket_addr_type* addr, std::size_t addrlen,
     std::error_code& ec, size_t& bytes_transferred);
 
+// One datagram in a batch passed to recvmmsg() or sendmmsg().
+struct mmsg_slot
+{
+  buf data;
+  socket_addr_type* addr;
+  std::size_t addrlen;
+  size_t bytes_transferred;
+};
+
+// The largest number of datagrams transferred by a single batch call.
+enum { max_mmsg_slots = 64 };
+
+NET_TS_DECL signed_size_type recvmmsg(socket_type s, mmsg_slot* slots,
+    size_t count, int flags, std::error_code& ec);
+
+NET_TS_DECL bool non_blocking_recvmmsg(socket_type s,
+    mmsg_slot* slots, size_t count, int flags,
+    std::error_code& ec, size_t& messages_transferred);
+
+NET_TS_DECL signed_size_type sendmmsg(socket_type s, mmsg_slot* slots,
+    size_t count, int flags, std::error_code& ec);
+
+NET_TS_DECL bool non_blocking_sendmmsg(socket_type s,
+    mmsg_slot* slots, size_t count, int flags,
+    std::error_code& ec, size_t& messages_transferred);
+
 #endif // !defined(NET_TS_HAS_IOCP)
 
 NET_TS_DECL socket_type socket(int af, int type, int protocol,
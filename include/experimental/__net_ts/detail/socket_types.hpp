@@ -84,6 +84,9 @@
 #  include <sys/filio.h>
 #  include <sys/sockio.h>
 # endif
+# if defined(NET_TS_HAS_IO_URING)
+#  include <linux/io_uring.h>
+# endif
 #endif
 
 #include <experimental/__net_ts/detail/push_options.hpp>
@@ -354,6 +357,9 @@ typedef int signed_size_type;
 # define NET_TS_OS_DEF_SO_SNDLOWAT SO_SNDLOWAT
 # define NET_TS_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define NET_TS_OS_DEF_SO_REUSEADDR SO_REUSEADDR
+# if defined(SO_REUSEPORT)
+#  define NET_TS_OS_DEF_SO_REUSEPORT SO_REUSEPORT
+# endif // defined(SO_REUSEPORT)
 # define NET_TS_OS_DEF_TCP_NODELAY TCP_NODELAY
 # define NET_TS_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define NET_TS_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
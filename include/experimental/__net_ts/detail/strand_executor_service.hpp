@@ -16,6 +16,9 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/detail/config.hpp>
+#if defined(NET_TS_HAS_STD_ATOMIC)
+# include <atomic>
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
 #include <experimental/__net_ts/detail/atomic_count.hpp>
 #include <experimental/__net_ts/detail/executor_op.hpp>
 #include <experimental/__net_ts/detail/memory.hpp>
@@ -33,6 +36,8 @@ namespace net {
 inline namespace v1 {
 namespace detail {
 
+class scheduler;
+
 // Default service implementation for a strand.
 class strand_executor_service
   : public execution_context_service_base<strand_executor_service>
@@ -47,6 +52,17 @@ public:
   private:
     friend class strand_executor_service;
 
+#if defined(NET_TS_HAS_STD_ATOMIC)
+    // The "locked" state of the strand together with the handlers that are
+    // waiting on it. The strand is locked when there is a handler upcall in
+    // progress, or when the strand itself has been scheduled in order to
+    // invoke some pending handlers. A null value means the strand is not
+    // locked. Otherwise the value is the most recently enqueued waiting
+    // handler, and the waiting handlers are linked newest first down to the
+    // locked marker. When there are no waiting handlers the value is the
+    // locked marker itself.
+    std::atomic<scheduler_operation*> state_;
+#else // defined(NET_TS_HAS_STD_ATOMIC)
     // Mutex to protect access to internal data.
     mutex* mutex_;
 
@@ -59,12 +75,29 @@ public:
     // after the next time the strand is scheduled. This queue must only be
     // modified while the mutex is locked.
     op_queue<scheduler_operation> waiting_queue_;
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<scheduler_operation> ready_queue_;
 
+    // The maximum number of handlers to run each time the strand is scheduled,
+    // or zero if there is no limit.
+    std::size_t max_handlers_;
+
+    // The maximum time to spend running handlers each time the strand is
+    // scheduled, in microseconds, or zero if there is no limit.
+    long max_usec_;
+
+    // Whether handlers enqueued while the strand is running may be run in the
+    // same turn when the scheduler has nothing else ready to run.
+    bool run_inline_;
+
+    // The scheduler of the strand's execution context, if it has one. Used to
+    // decide whether waiting handlers may be run inline.
+    scheduler* scheduler_;
+
     // Pointers to adjacent handle implementations in linked list.
     strand_impl* next_;
     strand_impl* prev_;
@@ -103,6 +136,10 @@ public:
   NET_TS_DECL static bool running_in_this_thread(
       const implementation_type& impl);
 
+  // Set the limits on the handlers run each time the strand is scheduled.
+  NET_TS_DECL static void set_batching(const implementation_type& impl,
+      std::size_t max_handlers, long max_usec, bool run_inline);
+
 private:
   friend class strand_impl;
   template <typename Executor> class invoker;
@@ -111,9 +148,37 @@ private:
   NET_TS_DECL static bool enqueue(const implementation_type& impl,
       scheduler_operation* op);
 
+  // Moves waiting handlers to the ready queue. Returns true if there are
+  // handlers to run, otherwise releases the lock and returns false.
+  NET_TS_DECL static bool push_waiting_to_ready(implementation_type& impl);
+
+  // Run ready handlers, subject to the strand's batching limits. Any handlers
+  // left in the ready queue are run the next time the strand is scheduled.
+  NET_TS_DECL static void run_ready_handlers(implementation_type& impl);
+
+  // Move waiting handlers to the ready queue, without releasing the lock, if
+  // the scheduler has nothing else ready to run. Returns true if any handlers
+  // were moved.
+  NET_TS_DECL static bool take_waiting_inline(implementation_type& impl);
+
+#if defined(NET_TS_HAS_STD_ATOMIC)
+  // Get the value used to mark the strand as locked. The marker is never
+  // dereferenced.
+  static scheduler_operation* locked_marker(strand_impl* impl)
+  {
+    return reinterpret_cast<scheduler_operation*>(impl);
+  }
+
+  // Take all waiting handlers from the strand, oldest first, leaving the
+  // strand locked.
+  NET_TS_DECL static void take_waiting(strand_impl* impl,
+      op_queue<scheduler_operation>& ops);
+#endif // defined(NET_TS_HAS_STD_ATOMIC)
+
   // Mutex to protect access to the service-wide state.
   mutex mutex_;
 
+#if !defined(NET_TS_HAS_STD_ATOMIC)
   // Number of mutexes shared between all strand objects.
   enum { num_mutexes = 193 };
 
@@ -123,6 +188,7 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same mutex.
   std::size_t salt_;
+#endif // !defined(NET_TS_HAS_STD_ATOMIC)
 
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
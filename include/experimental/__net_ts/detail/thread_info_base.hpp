@@ -15,75 +15,237 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#include <climits>
+#include <experimental/__net_ts/detail/config.hpp>
 #include <cstddef>
+#include <experimental/__net_ts/detail/cstdint.hpp>
 #include <experimental/__net_ts/detail/noncopyable.hpp>
 
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+# include <atomic>
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+
 #include <experimental/__net_ts/detail/push_options.hpp>
 
+// The number of freed blocks each thread keeps per size class.
+#if !defined(NET_TS_HANDLER_MEMORY_CACHE_SLOTS)
+# define NET_TS_HANDLER_MEMORY_CACHE_SLOTS 4
+#endif // !defined(NET_TS_HANDLER_MEMORY_CACHE_SLOTS)
+
+// The approximate number of blocks per size class that may be parked on the
+// shared return lists.
+#if !defined(NET_TS_HANDLER_MEMORY_RETURN_LIMIT)
+# define NET_TS_HANDLER_MEMORY_RETURN_LIMIT 64
+#endif // !defined(NET_TS_HANDLER_MEMORY_RETURN_LIMIT)
+
 namespace std {
 namespace experimental {
 namespace net {
 inline namespace v1 {
 namespace detail {
 
+// Per-thread cache of handler memory. Requests are rounded up to one of a
+// small number of power-of-two size classes, and each thread keeps a few
+// freed blocks of every class. Blocks freed on a thread whose cache is full,
+// or on a thread that is not running the io_context, are parked on a shared
+// lock-free return list so that the allocating thread can pick them up again
+// rather than going back to the heap. Requests larger than the biggest class
+// bypass the cache.
 class thread_info_base
   : private noncopyable
 {
 public:
+  enum
+  {
+    min_block_size = 64,
+    size_classes = 5,
+    cache_slots = NET_TS_HANDLER_MEMORY_CACHE_SLOTS,
+    return_limit = NET_TS_HANDLER_MEMORY_RETURN_LIMIT
+  };
+
   thread_info_base()
-    : reusable_memory_(0)
+    : loop_time_(0)
   {
+    for (int i = 0; i < size_classes; ++i)
+      cache_count_[i] = 0;
   }
 
   ~thread_info_base()
   {
-    if (reusable_memory_)
-      ::operator delete(reusable_memory_);
+    for (int i = 0; i < size_classes; ++i)
+      for (int j = 0; j < cache_count_[i]; ++j)
+        ::operator delete(cache_[i][j]);
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
   {
-    if (this_thread && this_thread->reusable_memory_)
+    const int c = size_class(size);
+    if (c < size_classes)
     {
-      void* const pointer = this_thread->reusable_memory_;
-      this_thread->reusable_memory_ = 0;
+      if (this_thread && this_thread->cache_count_[c] > 0)
+        return this_thread->cache_[c][--this_thread->cache_count_[c]];
 
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= size)
-      {
-        mem[size] = mem[0];
+      if (void* const pointer = reclaim(this_thread, c))
         return pointer;
-      }
 
-      ::operator delete(pointer);
+      return ::operator new(block_size(c));
     }
 
-    void* const pointer = ::operator new(size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (size <= UCHAR_MAX) ? static_cast<unsigned char>(size) : 0;
-    return pointer;
+    return ::operator new(size);
   }
 
   static void deallocate(thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= UCHAR_MAX)
+    const int c = size_class(size);
+    if (c < size_classes)
     {
-      if (this_thread && this_thread->reusable_memory_ == 0)
+      if (this_thread && this_thread->cache_count_[c] < cache_slots)
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_ = pointer;
+        this_thread->cache_[c][this_thread->cache_count_[c]++] = pointer;
         return;
       }
+
+      if (give_back(c, pointer))
+        return;
     }
 
     ::operator delete(pointer);
   }
 
+  // Get the time cached for the current step of the event loop, or zero if
+  // the clock must be read again.
+  int64_t loop_time() const
+  {
+    return loop_time_;
+  }
+
+  // Cache the time for the rest of the current step of the event loop.
+  void set_loop_time(int64_t t)
+  {
+    loop_time_ = t;
+  }
+
+  // Discard the cached time. Called whenever the thread starts running a
+  // handler or returns from waiting in the reactor.
+  void clear_loop_time()
+  {
+    loop_time_ = 0;
+  }
+
 private:
-  void* reusable_memory_;
+  // Get the size class for a request. Returns size_classes if the request is
+  // too large to be cached.
+  static int size_class(std::size_t size)
+  {
+    int c = 0;
+    std::size_t block = min_block_size;
+    while (c < size_classes && block < size)
+      ++c, block <<= 1;
+    return c;
+  }
+
+  static std::size_t block_size(int c)
+  {
+    return static_cast<std::size_t>(min_block_size) << c;
+  }
+
+#if defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  // A list of freed blocks of one size class, linked through their first
+  // word. Blocks are pushed one at a time and are only ever removed by
+  // taking the whole list, which avoids the ABA problem.
+  struct return_list
+  {
+    std::atomic<void*> top_;
+    std::atomic<std::size_t> count_;
+  };
+
+  // The return lists have static storage duration and a trivial destructor,
+  // so they remain usable during static destruction. Blocks still parked on
+  // them at exit are left for the operating system to reclaim.
+  static return_list& get_return_list(int c)
+  {
+    static return_list lists[size_classes];
+    return lists[c];
+  }
+
+  static void*& next(void* block)
+  {
+    return *static_cast<void**>(block);
+  }
+
+  static void push_blocks(return_list& list, void* first, void* last)
+  {
+    void* top = list.top_.load(std::memory_order_relaxed);
+    do
+    {
+      next(last) = top;
+    } while (!list.top_.compare_exchange_weak(top, first,
+          std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  static bool give_back(int c, void* pointer)
+  {
+    return_list& list = get_return_list(c);
+    if (list.count_.load(std::memory_order_relaxed) >= return_limit)
+      return false;
+
+    list.count_.fetch_add(1, std::memory_order_relaxed);
+    push_blocks(list, pointer, pointer);
+    return true;
+  }
+
+  static void* reclaim(thread_info_base* this_thread, int c)
+  {
+    return_list& list = get_return_list(c);
+    if (list.top_.load(std::memory_order_relaxed) == 0)
+      return 0;
+
+    void* const result = list.top_.exchange(0, std::memory_order_acquire);
+    if (result == 0)
+      return 0;
+
+    // Refill this thread's cache from the rest of the list.
+    std::size_t taken = 1;
+    void* rest = next(result);
+    if (this_thread)
+    {
+      while (rest && this_thread->cache_count_[c] < cache_slots)
+      {
+        void* const n = next(rest);
+        this_thread->cache_[c][this_thread->cache_count_[c]++] = rest;
+        rest = n;
+        ++taken;
+      }
+    }
+
+    list.count_.fetch_sub(taken, std::memory_order_relaxed);
+
+    // Anything left over goes back on the list for other threads.
+    if (rest)
+    {
+      void* last = rest;
+      while (next(last))
+        last = next(last);
+      push_blocks(list, rest, last);
+    }
+
+    return result;
+  }
+#else // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+  static bool give_back(int, void*)
+  {
+    return false;
+  }
+
+  static void* reclaim(thread_info_base*, int)
+  {
+    return 0;
+  }
+#endif // defined(NET_TS_HAS_THREADS) && defined(NET_TS_HAS_STD_ATOMIC)
+
+  void* cache_[size_classes][cache_slots];
+  int cache_count_[size_classes];
+  int64_t loop_time_;
 };
 
 } // namespace detail
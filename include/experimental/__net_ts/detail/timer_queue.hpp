@@ -28,6 +28,11 @@
 
 #include <experimental/__net_ts/detail/push_options.hpp>
 
+// The number of children of each item in a timer heap.
+#if !defined(NET_TS_TIMER_HEAP_ARITY)
+# define NET_TS_TIMER_HEAP_ARITY 4
+#endif // !defined(NET_TS_TIMER_HEAP_ARITY)
+
 namespace std {
 namespace experimental {
 namespace net {
@@ -50,8 +55,11 @@ public:
   {
   public:
     per_timer_data() :
+      expiry_(),
       heap_index_((std::numeric_limits<std::size_t>::max)()),
-      next_(0), prev_(0)
+      next_(0), prev_(0),
+      wheel_tick_(0),
+      slot_next_(0), slot_prev_(0)
     {
     }
 
@@ -61,21 +69,76 @@ public:
     // The operations waiting on the timer.
     op_queue<wait_op> op_queue_;
 
-    // The index of the timer in the heap.
+    // The time at which the timer expires. This may be later than the time
+    // used to order the timer in the heap, if the timer has been rescheduled.
+    time_type expiry_;
+
+    // The index of the timer in the heap, or of its slot in the timing wheel.
     std::size_t heap_index_;
 
     // Pointers to adjacent timers in a linked list.
     per_timer_data* next_;
     per_timer_data* prev_;
+
+    // The tick at which the timer expires, when a timing wheel is used.
+    int64_t wheel_tick_;
+
+    // Pointers to adjacent timers in the same timing wheel slot.
+    per_timer_data* slot_next_;
+    per_timer_data* slot_prev_;
   };
 
   // Constructor.
   timer_queue()
     : timers_(),
-      heap_()
+      heap_times_(),
+      heap_timers_(),
+      wheel_resolution_(0),
+      wheel_bits_(0),
+      wheel_levels_(0),
+      wheel_current_(0),
+      wheel_armed_tick_(0),
+      slack_(0),
+      slack_armed_usec_(0),
+      origin_()
   {
   }
 
+  // Order the timers using a hierarchical timing wheel rather than a heap.
+  // Timers are then inserted and cancelled in constant time, but may fire up
+  // to one tick late. Must be called before any timers are added.
+  void use_wheel(long resolution_usec,
+      std::size_t slots_per_level, std::size_t levels)
+  {
+    // The number of slots per level is rounded up to a power of two, and the
+    // range of the wheel is limited so that ticks cannot overflow.
+    wheel_bits_ = 1;
+    while (wheel_bits_ < 16
+        && (static_cast<std::size_t>(1) << wheel_bits_) < slots_per_level)
+      ++wheel_bits_;
+    wheel_levels_ = levels > 0 ? levels : 1;
+    while (wheel_levels_ > 1 && wheel_bits_ * wheel_levels_ > 48)
+      --wheel_levels_;
+
+    wheel_resolution_ = resolution_usec > 0 ? resolution_usec : 1;
+    wheel_slots_.assign((wheel_levels_ << wheel_bits_) + 1, 0);
+    wheel_counts_.assign(wheel_levels_ + 1, 0);
+    origin_ = Time_Traits::now();
+    wheel_current_ = 0;
+    wheel_armed_tick_ = (std::numeric_limits<int64_t>::max)();
+  }
+
+  // Allow timers to fire up to the specified number of microseconds late, so
+  // that timers expiring close together are dequeued by a single wake-up of
+  // the reactor. Must be called before any timers are added.
+  void set_slack(long slack_usec)
+  {
+    slack_ = slack_usec > 0 ? slack_usec : 0;
+    slack_armed_usec_ = (std::numeric_limits<int64_t>::max)();
+    if (!wheel_resolution_)
+      origin_ = Time_Traits::now();
+  }
+
   // Add a new timer to the queue. Returns true if this is the timer that is
   // earliest in the queue, in which case the reactor's event demultiplexing
   // function call may need to be interrupted and restarted.
@@ -84,19 +147,24 @@ public:
     // Enqueue the timer object.
     if (timer.prev_ == 0 && &timer != timers_)
     {
+      timer.expiry_ = time;
       if (this->is_positive_infinity(time))
       {
         // No heap entry is required for timers that never expire.
         timer.heap_index_ = (std::numeric_limits<std::size_t>::max)();
       }
+      else if (wheel_resolution_)
+      {
+        // Put the new timer into the timing wheel slot for its tick.
+        timer.wheel_tick_ = wheel_tick(time);
+        wheel_insert(timer);
+      }
       else
       {
         // Put the new timer at the correct position in the heap. This is done
-        // first since push_back() can throw due to allocation failure.
-        timer.heap_index_ = heap_.size();
-        heap_entry entry = { time, &timer };
-        heap_.push_back(entry);
-        up_heap(heap_.size() - 1);
+        // first since adding it to the heap can throw due to allocation
+        // failure.
+        push_heap(time, timer);
       }
 
       // Insert the new timer into the linked list of active timers.
@@ -111,7 +179,43 @@ public:
     timer.op_queue_.push(op);
 
     // Interrupt reactor only if newly added timer is first to expire.
-    return timer.heap_index_ == 0 && timer.op_queue_.front() == op;
+    return is_earliest(timer, time) && timer.op_queue_.front() == op;
+  }
+
+  // Change the expiry time of a timer without dequeuing the operations that
+  // are waiting on it. Returns true if the reactor's event demultiplexing
+  // function call may need to be interrupted and restarted. A timer that is
+  // moved later keeps its position in the heap until its old expiry time is
+  // reached, and is only then moved to its new position.
+  bool reschedule_timer(per_timer_data& timer, const time_type& time)
+  {
+    if (timer.prev_ == 0 && &timer != timers_)
+      return false;
+
+    timer.expiry_ = time;
+    if (wheel_resolution_)
+    {
+      wheel_remove(timer);
+      if (this->is_positive_infinity(time))
+        return false;
+      timer.wheel_tick_ = wheel_tick(time);
+      wheel_insert(timer);
+    }
+    else if (timer.heap_index_ >= heap_timers_.size())
+    {
+      if (this->is_positive_infinity(time))
+        return false;
+      push_heap(time, timer);
+    }
+    else if (Time_Traits::less_than(time, heap_times_[timer.heap_index_]))
+    {
+      heap_times_[timer.heap_index_] = time;
+      up_heap(timer.heap_index_);
+    }
+    else
+      return false;
+
+    return is_earliest(timer, time);
   }
 
   // Whether there are no timers in the queue.
@@ -123,40 +227,78 @@ public:
   // Get the time for the timer that is earliest in the queue.
   virtual long wait_duration_msec(long max_duration) const
   {
-    if (heap_.empty())
+    if (wheel_resolution_ || slack_)
+    {
+      int64_t usec = wheel_resolution_ ? wheel_wait_usec() : slack_wait_usec();
+      if (usec < 0)
+        return max_duration;
+      if (usec == 0)
+        return 0;
+      int64_t msec = (usec + 999) / 1000;
+      return msec > max_duration ? max_duration : static_cast<long>(msec);
+    }
+
+    if (heap_timers_.empty())
       return max_duration;
 
     return this->to_msec(
         Time_Traits::to_posix_duration(
-          Time_Traits::subtract(heap_[0].time_, Time_Traits::now())),
+          Time_Traits::subtract(heap_times_[0], Time_Traits::now())),
         max_duration);
   }
 
   // Get the time for the timer that is earliest in the queue.
   virtual long wait_duration_usec(long max_duration) const
   {
-    if (heap_.empty())
+    if (wheel_resolution_ || slack_)
+    {
+      int64_t usec = wheel_resolution_ ? wheel_wait_usec() : slack_wait_usec();
+      if (usec < 0 || usec > max_duration)
+        return max_duration;
+      return static_cast<long>(usec);
+    }
+
+    if (heap_timers_.empty())
       return max_duration;
 
     return this->to_usec(
         Time_Traits::to_posix_duration(
-          Time_Traits::subtract(heap_[0].time_, Time_Traits::now())),
+          Time_Traits::subtract(heap_times_[0], Time_Traits::now())),
         max_duration);
   }
 
-  // Dequeue all timers not later than the current time.
-  virtual void get_ready_timers(op_queue<operation>& ops)
+  // Dequeue all timers not later than the current time. Returns the number of
+  // timers dequeued.
+  virtual std::size_t get_ready_timers(op_queue<operation>& ops)
   {
-    if (!heap_.empty())
+    // The reactor recalculates its timeout after dequeuing the ready timers.
+    wheel_armed_tick_ = (std::numeric_limits<int64_t>::max)();
+    slack_armed_usec_ = (std::numeric_limits<int64_t>::max)();
+
+    std::size_t n = 0;
+    if (wheel_resolution_)
+      n = wheel_advance(ops);
+    else if (!heap_timers_.empty())
     {
       const time_type now = Time_Traits::now();
-      while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
+      while (!heap_timers_.empty()
+          && !Time_Traits::less_than(now, heap_times_[0]))
       {
-        per_timer_data* timer = heap_[0].timer_;
+        per_timer_data* timer = heap_timers_[0];
+        if (Time_Traits::less_than(now, timer->expiry_))
+        {
+          // The timer was rescheduled to a later time after it was added.
+          heap_times_[0] = timer->expiry_;
+          down_heap(0);
+          continue;
+        }
+
         ops.push(timer->op_queue_);
         remove_timer(*timer);
+        ++n;
       }
     }
+    return n;
   }
 
   // Dequeue all timers.
@@ -169,9 +311,17 @@ public:
       ops.push(timer->op_queue_);
       timer->next_ = 0;
       timer->prev_ = 0;
+      timer->heap_index_ = (std::numeric_limits<std::size_t>::max)();
+      timer->slot_next_ = 0;
+      timer->slot_prev_ = 0;
     }
 
-    heap_.clear();
+    heap_times_.clear();
+    heap_timers_.clear();
+    for (std::size_t i = 0; i < wheel_slots_.size(); ++i)
+      wheel_slots_[i] = 0;
+    for (std::size_t i = 0; i < wheel_counts_.size(); ++i)
+      wheel_counts_[i] = 0;
   }
 
   // Cancel and dequeue operations for the given timer.
@@ -200,11 +350,30 @@ public:
   {
     target.op_queue_.push(source.op_queue_);
 
+    target.expiry_ = source.expiry_;
+
     target.heap_index_ = source.heap_index_;
     source.heap_index_ = (std::numeric_limits<std::size_t>::max)();
 
-    if (target.heap_index_ < heap_.size())
-      heap_[target.heap_index_].timer_ = &target;
+    if (wheel_resolution_)
+    {
+      target.wheel_tick_ = source.wheel_tick_;
+      if (target.heap_index_ < wheel_slots_.size())
+      {
+        if (source.slot_prev_)
+          source.slot_prev_->slot_next_ = &target;
+        else
+          wheel_slots_[target.heap_index_] = &target;
+        if (source.slot_next_)
+          source.slot_next_->slot_prev_ = &target;
+      }
+      target.slot_next_ = source.slot_next_;
+      target.slot_prev_ = source.slot_prev_;
+      source.slot_next_ = 0;
+      source.slot_prev_ = 0;
+    }
+    else if (target.heap_index_ < heap_timers_.size())
+      heap_timers_[target.heap_index_] = &target;
 
     if (timers_ == &source)
       timers_ = &target;
@@ -219,45 +388,76 @@ public:
   }
 
 private:
+  // Add a timer to the heap and move it up to its correct position. Both
+  // vectors are grown before either is changed, so that an allocation failure
+  // leaves the heap unmodified.
+  void push_heap(const time_type& time, per_timer_data& timer)
+  {
+    std::size_t size = heap_timers_.size();
+    if (size == heap_times_.capacity() || size == heap_timers_.capacity())
+    {
+      std::size_t capacity = size < 8 ? 16 : size * 2;
+      heap_times_.reserve(capacity);
+      heap_timers_.reserve(capacity);
+    }
+
+    heap_times_.push_back(time);
+    heap_timers_.push_back(&timer);
+    up_heap(size);
+  }
+
   // Move the item at the given index up the heap to its correct position.
   void up_heap(std::size_t index)
   {
+    const time_type time = heap_times_[index];
+    per_timer_data* timer = heap_timers_[index];
     while (index > 0)
     {
-      std::size_t parent = (index - 1) / 2;
-      if (!Time_Traits::less_than(heap_[index].time_, heap_[parent].time_))
+      std::size_t parent = (index - 1) / heap_arity;
+      if (!Time_Traits::less_than(time, heap_times_[parent]))
         break;
-      swap_heap(index, parent);
+      move_heap(parent, index);
       index = parent;
     }
+    heap_times_[index] = time;
+    heap_timers_[index] = timer;
+    timer->heap_index_ = index;
   }
 
   // Move the item at the given index down the heap to its correct position.
   void down_heap(std::size_t index)
   {
-    std::size_t child = index * 2 + 1;
-    while (child < heap_.size())
+    const std::size_t size = heap_times_.size();
+    const time_type time = heap_times_[index];
+    per_timer_data* timer = heap_timers_[index];
+    for (;;)
     {
-      std::size_t min_child = (child + 1 == heap_.size()
-          || Time_Traits::less_than(
-            heap_[child].time_, heap_[child + 1].time_))
-        ? child : child + 1;
-      if (Time_Traits::less_than(heap_[index].time_, heap_[min_child].time_))
+      // The children of an item are adjacent, so finding the earliest only
+      // touches the packed times.
+      std::size_t child = index * heap_arity + 1;
+      if (child >= size)
         break;
-      swap_heap(index, min_child);
+      std::size_t end = size - child > heap_arity ? child + heap_arity : size;
+      std::size_t min_child = child;
+      for (++child; child < end; ++child)
+        if (Time_Traits::less_than(heap_times_[child], heap_times_[min_child]))
+          min_child = child;
+      if (!Time_Traits::less_than(heap_times_[min_child], time))
+        break;
+      move_heap(min_child, index);
       index = min_child;
-      child = index * 2 + 1;
     }
+    heap_times_[index] = time;
+    heap_timers_[index] = timer;
+    timer->heap_index_ = index;
   }
 
-  // Swap two entries in the heap.
-  void swap_heap(std::size_t index1, std::size_t index2)
+  // Move the item at one index of the heap to another.
+  void move_heap(std::size_t from, std::size_t to)
   {
-    heap_entry tmp = heap_[index1];
-    heap_[index1] = heap_[index2];
-    heap_[index2] = tmp;
-    heap_[index1].timer_->heap_index_ = index1;
-    heap_[index2].timer_->heap_index_ = index2;
+    heap_times_[to] = heap_times_[from];
+    heap_timers_[to] = heap_timers_[from];
+    heap_timers_[to]->heap_index_ = to;
   }
 
   // Remove a timer from the heap and list of timers.
@@ -265,18 +465,19 @@ private:
   {
     // Remove the timer from the heap.
     std::size_t index = timer.heap_index_;
-    if (!heap_.empty() && index < heap_.size())
+    if (wheel_resolution_)
+      wheel_remove(timer);
+    else if (!heap_timers_.empty() && index < heap_timers_.size())
     {
-      if (index == heap_.size() - 1)
-      {
-        heap_.pop_back();
-      }
-      else
+      std::size_t last = heap_timers_.size() - 1;
+      if (index != last)
+        move_heap(last, index);
+      heap_times_.pop_back();
+      heap_timers_.pop_back();
+      if (index != last)
       {
-        swap_heap(index, heap_.size() - 1);
-        heap_.pop_back();
         if (index > 0 && Time_Traits::less_than(
-              heap_[index].time_, heap_[(index - 1) / 2].time_))
+              heap_times_[index], heap_times_[(index - 1) / heap_arity]))
           up_heap(index);
         else
           down_heap(index);
@@ -294,6 +495,262 @@ private:
     timer.prev_ = 0;
   }
 
+  // Determine whether the given timer is due before the time at which the
+  // reactor will next dequeue timers.
+  bool is_earliest(const per_timer_data& timer, const time_type& time) const
+  {
+    if (wheel_resolution_)
+      return timer.heap_index_ == wheel_due_index()
+        || (timer.heap_index_ < wheel_slots_.size()
+          && wheel_slack_tick(timer.wheel_tick_) < wheel_armed_tick_);
+    if (slack_)
+      return timer.heap_index_ == 0
+        && slack_wake_usec(time) < slack_armed_usec_;
+    return timer.heap_index_ == 0;
+  }
+
+  // Get the number of microseconds from the origin to a time.
+  int64_t offset_usec(const time_type& time) const
+  {
+    return Time_Traits::to_posix_duration(
+        Time_Traits::subtract(time, origin_)).total_microseconds();
+  }
+
+  // Get the tick at which a timer with the given expiry may fire. The tick is
+  // rounded up so that timers never fire early.
+  int64_t wheel_tick(const time_type& time) const
+  {
+    int64_t usec = offset_usec(time);
+    if (usec < 0)
+      return wheel_current_;
+    return usec / wheel_resolution_ + 1;
+  }
+
+  // The index of the slot holding timers that are already due.
+  std::size_t wheel_due_index() const
+  {
+    return wheel_slots_.size() - 1;
+  }
+
+  // Put a timer into the slot for its tick. Timers are placed on the lowest
+  // level that spans their remaining time, and are moved down a level each
+  // time the level below wraps around.
+  void wheel_insert(per_timer_data& timer)
+  {
+    const int64_t mask = (static_cast<int64_t>(1) << wheel_bits_) - 1;
+    std::size_t index = wheel_due_index();
+    std::size_t level = wheel_levels_;
+    if (timer.wheel_tick_ > wheel_current_)
+    {
+      int64_t tick = timer.wheel_tick_;
+      int64_t delta = tick - wheel_current_;
+      level = 0;
+      while (level + 1 < wheel_levels_
+          && delta >= (static_cast<int64_t>(1) << (wheel_bits_ * (level + 1))))
+        ++level;
+
+      // Timers beyond the range of the wheel are parked in the last slot it
+      // reaches, and are placed again when that slot is cascaded.
+      int64_t range = static_cast<int64_t>(1) << (wheel_bits_ * wheel_levels_);
+      if (delta >= range)
+        tick = wheel_current_ + range - 1;
+
+      index = (level << wheel_bits_)
+        + static_cast<std::size_t>((tick >> (wheel_bits_ * level)) & mask);
+    }
+
+    timer.heap_index_ = index;
+    timer.slot_prev_ = 0;
+    timer.slot_next_ = wheel_slots_[index];
+    if (timer.slot_next_)
+      timer.slot_next_->slot_prev_ = &timer;
+    wheel_slots_[index] = &timer;
+    ++wheel_counts_[level];
+  }
+
+  // Remove a timer from its timing wheel slot.
+  void wheel_remove(per_timer_data& timer)
+  {
+    std::size_t index = timer.heap_index_;
+    if (index >= wheel_slots_.size())
+      return;
+
+    if (timer.slot_prev_)
+      timer.slot_prev_->slot_next_ = timer.slot_next_;
+    else
+      wheel_slots_[index] = timer.slot_next_;
+    if (timer.slot_next_)
+      timer.slot_next_->slot_prev_ = timer.slot_prev_;
+    timer.slot_next_ = 0;
+    timer.slot_prev_ = 0;
+    timer.heap_index_ = (std::numeric_limits<std::size_t>::max)();
+    --wheel_counts_[index == wheel_due_index() ? wheel_levels_
+      : (index >> wheel_bits_)];
+  }
+
+  // Get the number of timers in the wheel, excluding those already due.
+  std::size_t wheel_pending_count(std::size_t first_level) const
+  {
+    std::size_t n = 0;
+    for (std::size_t level = first_level; level < wheel_levels_; ++level)
+      n += wheel_counts_[level];
+    return n;
+  }
+
+  // Advance the wheel to the current time, dequeuing all due timers. Returns
+  // the number of timers dequeued.
+  std::size_t wheel_advance(op_queue<operation>& ops)
+  {
+    const int64_t mask = (static_cast<int64_t>(1) << wheel_bits_) - 1;
+    const int64_t now_tick =
+      offset_usec(Time_Traits::now()) / wheel_resolution_;
+
+    std::size_t n = 0;
+    for (;;)
+    {
+      n += wheel_fire(wheel_due_index(), ops);
+
+      if (wheel_current_ >= now_tick)
+        break;
+
+      if (wheel_pending_count(0) == 0)
+      {
+        wheel_current_ = now_tick;
+        break;
+      }
+
+      // Skip the rest of the lowest level if there is nothing in it.
+      if (wheel_counts_[0] == 0)
+      {
+        int64_t last = wheel_current_ | mask;
+        if (last >= now_tick)
+        {
+          wheel_current_ = now_tick;
+          break;
+        }
+        wheel_current_ = last;
+      }
+
+      ++wheel_current_;
+
+      // When a level wraps around, the timers in the next slot of the level
+      // above are redistributed to the lower levels.
+      for (std::size_t level = 1; level < wheel_levels_; ++level)
+      {
+        int64_t level_mask =
+          (static_cast<int64_t>(1) << (wheel_bits_ * level)) - 1;
+        if ((wheel_current_ & level_mask) != 0)
+          break;
+
+        std::size_t index = (level << wheel_bits_) + static_cast<std::size_t>(
+            (wheel_current_ >> (wheel_bits_ * level)) & mask);
+        per_timer_data* timer = wheel_slots_[index];
+        wheel_slots_[index] = 0;
+        while (timer)
+        {
+          per_timer_data* next = timer->slot_next_;
+          --wheel_counts_[level];
+          wheel_insert(*timer);
+          timer = next;
+        }
+      }
+
+      n += wheel_fire(static_cast<std::size_t>(wheel_current_ & mask), ops);
+    }
+
+    return n;
+  }
+
+  // Dequeue all timers in a slot. Returns the number of timers dequeued.
+  std::size_t wheel_fire(std::size_t index, op_queue<operation>& ops)
+  {
+    std::size_t n = 0;
+    while (per_timer_data* timer = wheel_slots_[index])
+    {
+      ops.push(timer->op_queue_);
+      remove_timer(*timer);
+      ++n;
+    }
+    return n;
+  }
+
+  // Get the number of microseconds until the wheel next needs to be advanced,
+  // or a negative value if there are no timers in the wheel.
+  int64_t wheel_wait_usec() const
+  {
+    const int64_t slots = static_cast<int64_t>(1) << wheel_bits_;
+    const int64_t mask = slots - 1;
+
+    int64_t next = -1;
+    if (wheel_slots_[wheel_due_index()])
+      next = wheel_current_;
+    else
+    {
+      const int64_t boundary = (wheel_current_ | mask) + 1;
+      const bool higher = wheel_pending_count(1) > 0;
+      if (wheel_counts_[0] > 0)
+      {
+        for (int64_t tick = wheel_current_ + 1;
+            tick < wheel_current_ + slots; ++tick)
+        {
+          if ((higher && tick == boundary)
+              || wheel_slots_[static_cast<std::size_t>(tick & mask)])
+          {
+            next = tick;
+            break;
+          }
+        }
+      }
+      if (next < 0 && higher)
+        next = boundary;
+      if (next >= 0)
+        next = wheel_slack_tick(next);
+    }
+
+    wheel_armed_tick_ = next < 0 ? (std::numeric_limits<int64_t>::max)() : next;
+    if (next < 0)
+      return -1;
+
+    int64_t usec = next * wheel_resolution_
+      - offset_usec(Time_Traits::now());
+    return usec > 0 ? usec : 0;
+  }
+
+  // Round a tick up to the end of its slack window.
+  int64_t wheel_slack_tick(int64_t tick) const
+  {
+    const int64_t window = slack_ / wheel_resolution_;
+    if (window <= 1)
+      return tick;
+    return (tick + window - 1) / window * window;
+  }
+
+  // Get the time, as an offset from the origin, at which a timer with the
+  // given expiry is dequeued when slack is allowed. Expiries are rounded up
+  // to the end of a fixed window so that nearby timers share a wake-up.
+  int64_t slack_wake_usec(const time_type& time) const
+  {
+    int64_t usec = offset_usec(time);
+    if (usec <= 0)
+      return usec;
+    return (usec + slack_ - 1) / slack_ * slack_;
+  }
+
+  // Get the number of microseconds until the earliest timer's slack window
+  // ends, or a negative value if there are no timers in the heap.
+  int64_t slack_wait_usec() const
+  {
+    if (heap_timers_.empty())
+    {
+      slack_armed_usec_ = (std::numeric_limits<int64_t>::max)();
+      return -1;
+    }
+
+    slack_armed_usec_ = slack_wake_usec(heap_times_[0]);
+    int64_t usec = slack_armed_usec_ - offset_usec(Time_Traits::now());
+    return usec > 0 ? usec : 0;
+  }
+
   // Determine if the specified absolute time is positive infinity.
   template <typename Time_Type>
   static bool is_positive_infinity(const Time_Type&)
@@ -340,17 +797,49 @@ private:
   // The head of a linked list of all active timers.
   per_timer_data* timers_;
 
-  struct heap_entry
-  {
-    // The time when the timer should fire.
-    time_type time_;
+  // The number of children of each item in the heap.
+  enum { heap_arity = NET_TS_TIMER_HEAP_ARITY };
 
-    // The associated timer with enqueued operations.
-    per_timer_data* timer_;
-  };
+  // The heap of timers, with the earliest timer at the front. The times when
+  // the timers should fire are kept apart from the associated timers, so
+  // that comparing the children of an item reads consecutive memory.
+  std::vector<time_type> heap_times_;
+  std::vector<per_timer_data*> heap_timers_;
+
+  // The length of a timing wheel tick in microseconds, or zero if the timers
+  // are ordered using the heap.
+  int64_t wheel_resolution_;
+
+  // The base two logarithm of the number of slots in each level of the wheel.
+  std::size_t wheel_bits_;
+
+  // The number of levels in the wheel.
+  std::size_t wheel_levels_;
+
+  // The heads of the lists of timers in each slot, level by level, followed
+  // by the list of timers that are already due.
+  std::vector<per_timer_data*> wheel_slots_;
+
+  // The number of timers on each level, followed by the number already due.
+  std::vector<std::size_t> wheel_counts_;
+
+  // The last tick for which timers have been dequeued.
+  int64_t wheel_current_;
+
+  // The tick at which the reactor was last told to advance the wheel.
+  mutable int64_t wheel_armed_tick_;
+
+  // The number of microseconds by which timers may fire late, or zero if
+  // each timer fires as soon as it expires.
+  int64_t slack_;
+
+  // The time, as an offset from the origin, at which the reactor was last
+  // told to dequeue timers when slack is allowed.
+  mutable int64_t slack_armed_usec_;
 
-  // The heap of timers, with the earliest timer at the front.
-  std::vector<heap_entry> heap_;
+  // The time corresponding to tick zero and to the start of the first slack
+  // window.
+  time_type origin_;
 };
 
 } // namespace detail
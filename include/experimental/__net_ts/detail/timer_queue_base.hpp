@@ -47,8 +47,8 @@ public:
   // Get the time to wait until the next timer.
   virtual long wait_duration_usec(long max_duration) const = 0;
 
-  // Dequeue all ready timers.
-  virtual void get_ready_timers(op_queue<operation>& ops) = 0;
+  // Dequeue all ready timers. Returns the number of timers dequeued.
+  virtual std::size_t get_ready_timers(op_queue<operation>& ops) = 0;
 
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
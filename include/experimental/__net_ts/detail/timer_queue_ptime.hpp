@@ -54,6 +54,13 @@ public:
   // Destructor.
   NET_TS_DECL virtual ~timer_queue();
 
+  // Order the timers using a hierarchical timing wheel rather than a heap.
+  NET_TS_DECL void use_wheel(long resolution_usec,
+      std::size_t slots_per_level, std::size_t levels);
+
+  // Allow timers to fire late so that nearby expiries share a wake-up.
+  NET_TS_DECL void set_slack(long slack_usec);
+
   // Add a new timer to the queue. Returns true if this is the timer that is
   // earliest in the queue, in which case the reactor's event demultiplexing
   // function call may need to be interrupted and restarted.
@@ -70,7 +77,7 @@ public:
   NET_TS_DECL virtual long wait_duration_usec(long max_duration) const;
 
   // Dequeue all timers not later than the current time.
-  NET_TS_DECL virtual void get_ready_timers(op_queue<operation>& ops);
+  NET_TS_DECL virtual std::size_t get_ready_timers(op_queue<operation>& ops);
 
   // Dequeue all timers.
   NET_TS_DECL virtual void get_all_timers(op_queue<operation>& ops);
@@ -84,6 +91,10 @@ public:
   NET_TS_DECL void move_timer(per_timer_data& target,
       per_timer_data& source);
 
+  // Change the expiry time of a timer without dequeuing its operations.
+  NET_TS_DECL bool reschedule_timer(per_timer_data& timer,
+      const time_type& time);
+
 private:
   timer_queue<forwarding_posix_time_traits> impl_;
 };
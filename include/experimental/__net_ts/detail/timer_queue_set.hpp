@@ -47,8 +47,8 @@ public:
   // Get the wait duration in microseconds.
   NET_TS_DECL long wait_duration_usec(long max_duration) const;
 
-  // Dequeue all ready timers.
-  NET_TS_DECL void get_ready_timers(op_queue<operation>& ops);
+  // Dequeue all ready timers. Returns the number of timers dequeued.
+  NET_TS_DECL std::size_t get_ready_timers(op_queue<operation>& ops);
 
   // Dequeue all timers.
   NET_TS_DECL void get_all_timers(op_queue<operation>& ops);
@@ -22,6 +22,8 @@
 # include <experimental/__net_ts/detail/winrt_timer_scheduler.hpp>
 #elif defined(NET_TS_HAS_IOCP)
 # include <experimental/__net_ts/detail/win_iocp_io_context.hpp>
+#elif defined(NET_TS_HAS_IO_URING)
+# include <experimental/__net_ts/detail/io_uring_reactor.hpp>
 #elif defined(NET_TS_HAS_EPOLL)
 # include <experimental/__net_ts/detail/epoll_reactor.hpp>
 #elif defined(NET_TS_HAS_KQUEUE)
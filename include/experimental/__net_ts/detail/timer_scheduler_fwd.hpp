@@ -27,6 +27,8 @@ namespace detail {
 typedef class winrt_timer_scheduler timer_scheduler;
 #elif defined(NET_TS_HAS_IOCP)
 typedef class win_iocp_io_context timer_scheduler;
+#elif defined(NET_TS_HAS_IO_URING)
+typedef class io_uring_reactor timer_scheduler;
 #elif defined(NET_TS_HAS_EPOLL)
 typedef class epoll_reactor timer_scheduler;
 #elif defined(NET_TS_HAS_KQUEUE)
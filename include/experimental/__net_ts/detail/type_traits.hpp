@@ -21,6 +21,7 @@
 # include <type_traits>
 #else // defined(NET_TS_HAS_TYPE_TRAITS)
 # include <boost/type_traits/add_const.hpp>
+# include <boost/type_traits/alignment_of.hpp>
 # include <boost/type_traits/conditional.hpp>
 # include <boost/type_traits/decay.hpp>
 # include <boost/type_traits/integral_constant.hpp>
@@ -43,6 +44,7 @@ inline namespace v1 {
 
 #if defined(NET_TS_HAS_STD_TYPE_TRAITS)
 using std::add_const;
+using std::alignment_of;
 using std::conditional;
 using std::decay;
 using std::enable_if;
@@ -60,6 +62,7 @@ using std::result_of;
 using std::true_type;
 #else // defined(NET_TS_HAS_STD_TYPE_TRAITS)
 using boost::add_const;
+using boost::alignment_of;
 template <bool Condition, typename Type = void>
 struct enable_if : boost::enable_if_c<Condition, Type> {};
 using boost::conditional;
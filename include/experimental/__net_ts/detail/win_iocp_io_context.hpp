@@ -32,6 +32,7 @@
 #include <experimental/__net_ts/detail/win_iocp_operation.hpp>
 #include <experimental/__net_ts/detail/win_iocp_thread_info.hpp>
 #include <experimental/__net_ts/execution_context.hpp>
+#include <experimental/__net_ts/io_context_statistics.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
 
@@ -122,6 +123,24 @@ public:
     post_deferred_completion(op);
   }
 
+  // Request invocation of the given operation and return immediately. The
+  // completion port does not support priorities, so the operation is posted
+  // as for post_immediate_completion().
+  void post_priority_completion(win_iocp_operation* op, int, bool)
+  {
+    post_immediate_completion(op, false);
+  }
+
+  // Request invocation of the given operations and return immediately.
+  // Assumes that work_started() has not yet been called for the operations,
+  // of which there are n.
+  void post_immediate_completions(std::size_t n,
+      op_queue<win_iocp_operation>& ops, bool)
+  {
+    ::InterlockedExchangeAdd(&outstanding_work_, static_cast<long>(n));
+    post_deferred_completions(ops);
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   NET_TS_DECL void post_deferred_completion(win_iocp_operation* op);
@@ -203,12 +222,37 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& to,
       typename timer_queue<Time_Traits>::per_timer_data& from);
 
+  // Change the expiry time of the given timer without cancelling the
+  // operations waiting on it.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Get the concurrency hint that was used to initialise the io_context.
   int concurrency_hint() const
   {
     return concurrency_hint_;
   }
 
+  // Idle threads always block in GetQueuedCompletionStatus, so the idle spin
+  // and full polling settings are ignored.
+  void set_idle_spin(long)
+  {
+  }
+
+  void set_full_polling(bool)
+  {
+  }
+
+  // Take a snapshot of the statistics. Only the outstanding work is tracked.
+  void get_statistics(io_context_statistics& s)
+  {
+    s = io_context_statistics();
+    s.outstanding_work = static_cast<std::size_t>(
+        ::InterlockedExchangeAdd(&outstanding_work_, 0));
+  }
+
 private:
 #if defined(WINVER) && (WINVER < 0x0500)
   typedef DWORD dword_ptr_t;
@@ -20,6 +20,7 @@
 #include <experimental/__net_ts/detail/cstddef.hpp>
 #include <experimental/__net_ts/detail/memory.hpp>
 #include <experimental/__net_ts/detail/throw_exception.hpp>
+#include <experimental/__net_ts/detail/type_traits.hpp>
 #include <experimental/__net_ts/execution_context.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
@@ -60,16 +61,15 @@ public:
 
   /// Copy constructor.
   executor(const executor& other) NET_TS_NOEXCEPT
-    : impl_(other.clone())
+    : impl_(other.clone(&storage_))
   {
   }
 
 #if defined(NET_TS_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
   /// Move constructor.
   executor(executor&& other) NET_TS_NOEXCEPT
-    : impl_(other.impl_)
+    : impl_(other.release(&storage_))
   {
-    other.impl_ = 0;
   }
 #endif // defined(NET_TS_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
@@ -91,8 +91,11 @@ public:
   /// Assignment operator.
   executor& operator=(const executor& other) NET_TS_NOEXCEPT
   {
-    destroy();
-    impl_ = other.clone();
+    if (this != &other)
+    {
+      destroy();
+      impl_ = other.clone(&storage_);
+    }
     return *this;
   }
 
@@ -100,9 +103,11 @@ public:
   // Move assignment operator.
   executor& operator=(executor&& other) NET_TS_NOEXCEPT
   {
-    destroy();
-    impl_ = other.impl_;
-    other.impl_ = 0;
+    if (this != &other)
+    {
+      destroy();
+      impl_ = other.release(&storage_);
+    }
     return *this;
   }
 #endif // defined(NET_TS_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
@@ -122,8 +127,7 @@ public:
   {
     executor tmp(NET_TS_MOVE_CAST(Executor)(e));
     destroy();
-    impl_ = tmp.impl_;
-    tmp.impl_ = 0;
+    impl_ = tmp.release(&storage_);
     return *this;
   }
 
@@ -258,6 +262,15 @@ private:
 #if !defined(GENERATING_DOCUMENTATION)
   class function;
   template <typename, typename> class impl;
+  template <typename, typename> class small_impl;
+
+  // Inline storage used to hold small executors and small function objects
+  // without a separate allocation.
+  union small_storage
+  {
+    void* words_[6];
+    long double align_;
+  };
 
 #if !defined(NET_TS_NO_TYPEID)
   typedef const std::type_info& type_id_result_type;
@@ -280,7 +293,8 @@ private:
   class impl_base
   {
   public:
-    virtual impl_base* clone() const NET_TS_NOEXCEPT = 0;
+    virtual impl_base* clone(small_storage* s) const NET_TS_NOEXCEPT = 0;
+    virtual impl_base* move(small_storage* s) NET_TS_NOEXCEPT = 0;
     virtual void destroy() NET_TS_NOEXCEPT = 0;
     virtual execution_context& context() NET_TS_NOEXCEPT = 0;
     virtual void on_work_started() NET_TS_NOEXCEPT = 0;
@@ -313,10 +327,33 @@ private:
     return impl_;
   }
 
-  // Helper function to clone another implementation.
-  impl_base* clone() const NET_TS_NOEXCEPT
+  // Helper function to create an implementation for the given executor.
+  template <typename Executor, typename Allocator>
+  static impl_base* create(const Executor& e,
+      const Allocator& a, small_storage* s);
+
+  template <typename Executor, typename Allocator>
+  static impl_base* create(const Executor& e,
+      const Allocator& a, small_storage* s, true_type);
+
+  template <typename Executor, typename Allocator>
+  static impl_base* create(const Executor& e,
+      const Allocator& a, small_storage* s, false_type);
+
+  // Helper function to clone this implementation into another executor's
+  // storage.
+  impl_base* clone(small_storage* s) const NET_TS_NOEXCEPT
   {
-    return impl_ ? impl_->clone() : 0;
+    return impl_ ? impl_->clone(s) : 0;
+  }
+
+  // Helper function to transfer this implementation into another executor's
+  // storage, leaving this executor empty.
+  impl_base* release(small_storage* s) NET_TS_NOEXCEPT
+  {
+    impl_base* i = impl_ ? impl_->move(s) : 0;
+    impl_ = 0;
+    return i;
   }
 
   // Helper function to destroy an implementation.
@@ -327,6 +364,7 @@ private:
   }
 
   impl_base* impl_;
+  small_storage storage_;
 #endif // !defined(GENERATING_DOCUMENTATION)
 };
 
@@ -0,0 +1,69 @@
+//
+// impl/coarse_steady_clock.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IMPL_COARSE_STEADY_CLOCK_IPP
+#define NET_TS_IMPL_COARSE_STEADY_CLOCK_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+
+#if defined(NET_TS_HAS_CHRONO)
+
+#include <experimental/__net_ts/coarse_steady_clock.hpp>
+#include <experimental/__net_ts/detail/cstdint.hpp>
+#include <experimental/__net_ts/detail/thread_context.hpp>
+#include <experimental/__net_ts/detail/thread_info_base.hpp>
+
+#if !defined(NET_TS_WINDOWS) && !defined(__CYGWIN__)
+# include <time.h>
+#endif // !defined(NET_TS_WINDOWS) && !defined(__CYGWIN__)
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+coarse_steady_clock::time_point coarse_steady_clock::now() NET_TS_NOEXCEPT
+{
+  detail::thread_info_base* this_thread =
+    detail::thread_context::thread_call_stack::top();
+  if (this_thread)
+    if (int64_t t = this_thread->loop_time())
+      return time_point(duration(t));
+
+#if defined(CLOCK_MONOTONIC_COARSE)
+  timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+  int64_t t = static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else // defined(CLOCK_MONOTONIC_COARSE)
+  int64_t t = static_cast<int64_t>(chrono::duration_cast<duration>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+#endif // defined(CLOCK_MONOTONIC_COARSE)
+
+  if (this_thread)
+    this_thread->set_loop_time(t);
+  return time_point(duration(t));
+}
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // defined(NET_TS_HAS_CHRONO)
+
+#endif // NET_TS_IMPL_COARSE_STEADY_CLOCK_IPP
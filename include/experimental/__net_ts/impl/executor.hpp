@@ -18,9 +18,12 @@
 #include <experimental/__net_ts/detail/config.hpp>
 #include <experimental/__net_ts/detail/atomic_count.hpp>
 #include <experimental/__net_ts/detail/executor_op.hpp>
+#include <experimental/__net_ts/detail/fenced_block.hpp>
 #include <experimental/__net_ts/detail/global.hpp>
+#include <experimental/__net_ts/detail/handler_invoke_helpers.hpp>
 #include <experimental/__net_ts/detail/memory.hpp>
 #include <experimental/__net_ts/detail/recycling_allocator.hpp>
+#include <experimental/__net_ts/detail/type_traits.hpp>
 #include <experimental/__net_ts/executor.hpp>
 #include <experimental/__net_ts/system_executor.hpp>
 
@@ -35,35 +38,39 @@ inline namespace v1 {
 
 #if defined(NET_TS_HAS_MOVE)
 
-// Lightweight, move-only function object wrapper.
+// Lightweight, move-only function object wrapper. Function objects that fit
+// in the small buffer are stored inline, and larger ones are wrapped in an
+// operation allocated using the supplied allocator.
 class executor::function
 {
 public:
   template <typename F, typename Alloc>
   explicit function(F f, const Alloc& a)
+    : op_(0),
+      small_ops_(0)
   {
-    // Construct an allocator to be used for the operation.
-    typedef typename detail::get_recycling_allocator<Alloc>::type alloc_type;
-    alloc_type allocator(detail::get_recycling_allocator<Alloc>::get(a));
-
-    // Allocate and construct an operation to wrap the function.
-    typedef detail::executor_op<F, alloc_type> op;
-    typename op::ptr p = { allocator, 0, 0 };
-    p.v = p.a.allocate(1);
-    op_ = new (p.v) op(f, allocator);
-    p.v = 0;
+    init(f, a, integral_constant<bool,
+        sizeof(F) <= sizeof(small_storage)
+          && alignment_of<F>::value
+            <= alignment_of<small_storage>::value>());
   }
 
   function(function&& other)
-    : op_(other.op_)
+    : op_(other.op_),
+      small_ops_(other.small_ops_)
   {
+    if (small_ops_)
+      small_ops_->move(&other.storage_, &storage_);
     other.op_ = 0;
+    other.small_ops_ = 0;
   }
 
   ~function()
   {
     if (op_)
       op_->destroy();
+    if (small_ops_)
+      small_ops_->destroy(&storage_);
   }
 
   void operator()()
@@ -74,10 +81,87 @@ public:
       op_ = 0;
       op->complete(this, std::error_code(), 0);
     }
+    else if (small_ops_)
+    {
+      const small_function_ops* ops = small_ops_;
+      small_ops_ = 0;
+      ops->complete(&storage_);
+    }
   }
 
 private:
+  // Operations on a function object stored in the small buffer.
+  struct small_function_ops
+  {
+    void (*move)(small_storage*, small_storage*);
+    void (*destroy)(small_storage*);
+    void (*complete)(small_storage*);
+  };
+
+  template <typename F, typename Alloc>
+  void init(F& f, const Alloc&, true_type)
+  {
+    new (&storage_) F(NET_TS_MOVE_CAST(F)(f));
+    small_ops_ = small_ops<F>();
+  }
+
+  template <typename F, typename Alloc>
+  void init(F& f, const Alloc& a, false_type)
+  {
+    // Construct an allocator to be used for the operation.
+    typedef typename detail::get_recycling_allocator<Alloc>::type alloc_type;
+    alloc_type allocator(detail::get_recycling_allocator<Alloc>::get(a));
+
+    // Allocate and construct an operation to wrap the function.
+    typedef detail::executor_op<F, alloc_type> op;
+    typename op::ptr p = { allocator, 0, 0 };
+    p.v = p.a.allocate(1);
+    op_ = new (p.v) op(f, allocator);
+    p.v = 0;
+  }
+
+  template <typename F>
+  static const small_function_ops* small_ops()
+  {
+    static const small_function_ops ops =
+    {
+      &function::small_move<F>,
+      &function::small_destroy<F>,
+      &function::small_complete<F>
+    };
+    return &ops;
+  }
+
+  template <typename F>
+  static void small_move(small_storage* from, small_storage* to)
+  {
+    F* f = static_cast<F*>(static_cast<void*>(from));
+    new (to) F(NET_TS_MOVE_CAST(F)(*f));
+    f->~F();
+  }
+
+  template <typename F>
+  static void small_destroy(small_storage* s)
+  {
+    static_cast<F*>(static_cast<void*>(s))->~F();
+  }
+
+  template <typename F>
+  static void small_complete(small_storage* s)
+  {
+    // Make a local copy of the function object so that the storage is no
+    // longer in use when the upcall is made.
+    F* f = static_cast<F*>(static_cast<void*>(s));
+    F handler(NET_TS_MOVE_CAST(F)(*f));
+    f->~F();
+
+    detail::fenced_block b(detail::fenced_block::half);
+    networking_ts_handler_invoke_helpers::invoke(handler, handler);
+  }
+
   detail::scheduler_operation* op_;
+  const small_function_ops* small_ops_;
+  small_storage storage_;
 };
 
 #else // defined(NET_TS_HAS_MOVE)
@@ -153,12 +237,17 @@ public:
   {
   }
 
-  impl_base* clone() const NET_TS_NOEXCEPT
+  impl_base* clone(small_storage*) const NET_TS_NOEXCEPT
   {
     ++ref_count_;
     return const_cast<impl_base*>(static_cast<const impl_base*>(this));
   }
 
+  impl_base* move(small_storage*) NET_TS_NOEXCEPT
+  {
+    return this;
+  }
+
   void destroy() NET_TS_NOEXCEPT
   {
     if (--ref_count_ == 0)
@@ -270,11 +359,16 @@ public:
   {
   }
 
-  impl_base* clone() const NET_TS_NOEXCEPT
+  impl_base* clone(small_storage*) const NET_TS_NOEXCEPT
   {
     return const_cast<impl_base*>(static_cast<const impl_base*>(this));
   }
 
+  impl_base* move(small_storage*) NET_TS_NOEXCEPT
+  {
+    return this;
+  }
+
   void destroy() NET_TS_NOEXCEPT
   {
   }
@@ -334,15 +428,131 @@ private:
   Allocator allocator_;
 };
 
+// Polymorphic implementation stored inline within the executor object.
+template <typename Executor, typename Allocator>
+class executor::small_impl
+  : public executor::impl_base
+{
+public:
+  small_impl(const Executor& e, const Allocator& a) NET_TS_NOEXCEPT
+    : impl_base(false),
+      executor_(e),
+      allocator_(a)
+  {
+  }
+
+  impl_base* clone(small_storage* s) const NET_TS_NOEXCEPT
+  {
+    return new (s) small_impl(executor_, allocator_);
+  }
+
+  impl_base* move(small_storage* s) NET_TS_NOEXCEPT
+  {
+    small_impl* p = new (s) small_impl(
+        NET_TS_MOVE_CAST(Executor)(executor_), allocator_);
+    this->~small_impl();
+    return p;
+  }
+
+  void destroy() NET_TS_NOEXCEPT
+  {
+    this->~small_impl();
+  }
+
+  void on_work_started() NET_TS_NOEXCEPT
+  {
+    executor_.on_work_started();
+  }
+
+  void on_work_finished() NET_TS_NOEXCEPT
+  {
+    executor_.on_work_finished();
+  }
+
+  execution_context& context() NET_TS_NOEXCEPT
+  {
+    return executor_.context();
+  }
+
+  void dispatch(NET_TS_MOVE_ARG(function) f)
+  {
+    executor_.dispatch(NET_TS_MOVE_CAST(function)(f), allocator_);
+  }
+
+  void post(NET_TS_MOVE_ARG(function) f)
+  {
+    executor_.post(NET_TS_MOVE_CAST(function)(f), allocator_);
+  }
+
+  void defer(NET_TS_MOVE_ARG(function) f)
+  {
+    executor_.defer(NET_TS_MOVE_CAST(function)(f), allocator_);
+  }
+
+  type_id_result_type target_type() const NET_TS_NOEXCEPT
+  {
+    return type_id<Executor>();
+  }
+
+  void* target() NET_TS_NOEXCEPT
+  {
+    return &executor_;
+  }
+
+  const void* target() const NET_TS_NOEXCEPT
+  {
+    return &executor_;
+  }
+
+  bool equals(const impl_base* e) const NET_TS_NOEXCEPT
+  {
+    if (this == e)
+      return true;
+    if (target_type() != e->target_type())
+      return false;
+    return executor_ == *static_cast<const Executor*>(e->target());
+  }
+
+private:
+  Executor executor_;
+  Allocator allocator_;
+};
+
+template <typename Executor, typename Allocator>
+executor::impl_base* executor::create(const Executor& e,
+    const Allocator& a, small_storage* s)
+{
+  typedef small_impl<Executor, Allocator> small_type;
+  return create(e, a, s, integral_constant<bool,
+      !is_same<Executor, system_executor>::value
+        && sizeof(small_type) <= sizeof(small_storage)
+        && alignment_of<small_type>::value
+          <= alignment_of<small_storage>::value>());
+}
+
+template <typename Executor, typename Allocator>
+executor::impl_base* executor::create(const Executor& e,
+    const Allocator& a, small_storage* s, true_type)
+{
+  return new (s) small_impl<Executor, Allocator>(e, a);
+}
+
+template <typename Executor, typename Allocator>
+executor::impl_base* executor::create(const Executor& e,
+    const Allocator& a, small_storage*, false_type)
+{
+  return impl<Executor, Allocator>::create(e, a);
+}
+
 template <typename Executor>
 executor::executor(Executor e)
-  : impl_(impl<Executor, std::allocator<void> >::create(e))
+  : impl_(create(e, std::allocator<void>(), &storage_))
 {
 }
 
 template <typename Executor, typename Allocator>
 executor::executor(allocator_arg_t, const Allocator& a, Executor e)
-  : impl_(impl<Executor, Allocator>::create(e, a))
+  : impl_(create(e, a, &storage_))
 {
 }
 
@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <iterator>
 #include <experimental/__net_ts/detail/completion_handler.hpp>
 #include <experimental/__net_ts/detail/executor_op.hpp>
 #include <experimental/__net_ts/detail/fenced_block.hpp>
@@ -127,6 +128,22 @@ std::size_t io_context::run_one_until(
   return 0;
 }
 
+template <typename Rep, typename Period>
+void io_context::set_idle_spin(const chrono::duration<Rep, Period>& spin_time)
+{
+  // Negative durations are treated as zero, and a positive duration is
+  // never rounded down to zero.
+  long usec = 0;
+  if (spin_time > spin_time.zero())
+  {
+    usec = static_cast<long>(
+        chrono::duration_cast<chrono::microseconds>(spin_time).count());
+    if (usec < 1)
+      usec = 1;
+  }
+  impl_.set_idle_spin(usec);
+}
+
 #endif // defined(NET_TS_HAS_CHRONO)
 
 inline io_context&
@@ -205,6 +222,41 @@ void io_context::executor_type::post(
   p.v = p.p = 0;
 }
 
+template <typename InputIterator, typename Allocator>
+void io_context::executor_type::post_batch(
+    InputIterator first, InputIterator last, const Allocator& a) const
+{
+  typedef typename decay<typename std::iterator_traits<
+    InputIterator>::value_type>::type function_type;
+
+  // Construct an allocator to be used for the operations.
+  typedef typename detail::get_recycling_allocator<Allocator>::type alloc_type;
+  alloc_type allocator(detail::get_recycling_allocator<Allocator>::get(a));
+
+  // Allocate and construct an operation to wrap each function. If an
+  // exception is thrown, the operations constructed so far are destroyed
+  // along with the queue.
+  typedef detail::executor_op<function_type, alloc_type, detail::operation> op;
+  detail::op_queue<detail::operation> ops;
+  std::size_t n = 0;
+  for (; first != last; ++first, ++n)
+  {
+    function_type tmp(*first);
+
+    typename op::ptr p = { allocator, 0, 0 };
+    p.v = p.a.allocate(1);
+    p.p = new (p.v) op(tmp, allocator);
+
+    NET_TS_HANDLER_CREATION((this->context(), *p.p,
+          "io_context", &this->context(), 0, "post"));
+
+    ops.push(p.p);
+    p.v = p.p = 0;
+  }
+
+  io_context_.impl_.post_immediate_completions(n, ops, false);
+}
+
 template <typename Function, typename Allocator>
 void io_context::executor_type::defer(
     NET_TS_MOVE_ARG(Function) f, const Allocator& a) const
@@ -105,6 +105,18 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::set_full_polling(bool enable)
+{
+  impl_.set_full_polling(enable);
+}
+
+io_context_statistics io_context::statistics() const
+{
+  io_context_statistics s;
+  impl_.get_statistics(s);
+  return s;
+}
+
 io_context::service::service(std::experimental::net::io_context& owner)
   : execution_context::service(owner)
 {
@@ -0,0 +1,64 @@
+//
+// impl/io_context_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IMPL_IO_CONTEXT_POOL_HPP
+#define NET_TS_IMPL_IO_CONTEXT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+#if defined(NET_TS_OS_DEF_SO_REUSEPORT)
+
+template <typename Protocol>
+std::vector<basic_socket_acceptor<Protocol> > io_context_pool::open_acceptors(
+    const typename Protocol::endpoint& endpoint, int backlog)
+{
+  std::vector<basic_socket_acceptor<Protocol> > acceptors;
+  acceptors.reserve(io_contexts_.size());
+
+  typename Protocol::endpoint bound_endpoint = endpoint;
+  for (std::size_t i = 0; i < io_contexts_.size(); ++i)
+  {
+    basic_socket_acceptor<Protocol> acceptor(*io_contexts_[i]);
+    acceptor.open(bound_endpoint.protocol());
+    acceptor.set_option(socket_base::reuse_address(true));
+    acceptor.set_option(socket_base::reuse_port(true));
+    acceptor.bind(bound_endpoint);
+    acceptor.listen(backlog);
+
+    // Use the port chosen for the first acceptor for all of the others.
+    if (i == 0)
+      bound_endpoint = acceptor.local_endpoint();
+
+    acceptors.push_back(NET_TS_MOVE_CAST(
+          basic_socket_acceptor<Protocol>)(acceptor));
+  }
+
+  return acceptors;
+}
+
+#endif // defined(NET_TS_OS_DEF_SO_REUSEPORT)
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_IMPL_IO_CONTEXT_POOL_HPP
@@ -0,0 +1,161 @@
+//
+// impl/io_context_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IMPL_IO_CONTEXT_POOL_IPP
+#define NET_TS_IMPL_IO_CONTEXT_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <stdexcept>
+#include <experimental/__net_ts/io_context_pool.hpp>
+#include <experimental/__net_ts/detail/thread.hpp>
+#include <experimental/__net_ts/detail/throw_exception.hpp>
+
+#if defined(__linux__) && defined(NET_TS_HAS_PTHREADS)
+# include <pthread.h>
+# include <sched.h>
+#endif // defined(__linux__) && defined(NET_TS_HAS_PTHREADS)
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+struct io_context_pool::thread_function
+{
+  io_context* io_context_;
+  int cpu_;
+
+  void operator()()
+  {
+#if defined(__linux__) && defined(NET_TS_HAS_PTHREADS)
+    // Failure to pin the thread is not an error. The pool still works, only
+    // without the cache locality benefits.
+    if (cpu_ >= 0)
+    {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu_, &cpus);
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus);
+    }
+#endif // defined(__linux__) && defined(NET_TS_HAS_PTHREADS)
+
+    io_context_->run();
+  }
+};
+
+io_context_pool::io_context_pool()
+  : next_io_context_(0)
+{
+  std::size_t pool_size = detail::thread::hardware_concurrency();
+  start(pool_size > 0 ? pool_size : 1);
+}
+
+io_context_pool::io_context_pool(std::size_t pool_size)
+  : next_io_context_(0)
+{
+  start(pool_size);
+}
+
+io_context_pool::~io_context_pool()
+{
+  stop();
+  join();
+}
+
+io_context& io_context_pool::get_io_context()
+{
+  std::size_t index = static_cast<std::size_t>(++next_io_context_ - 1);
+  return *io_contexts_[index % io_contexts_.size()];
+}
+
+void io_context_pool::stop()
+{
+  for (std::size_t i = 0; i < io_contexts_.size(); ++i)
+    io_contexts_[i]->stop();
+}
+
+void io_context_pool::join()
+{
+  for (std::size_t i = 0; i < work_.size(); ++i)
+    work_[i].reset();
+  threads_.join();
+}
+
+void io_context_pool::start(std::size_t pool_size)
+{
+  if (pool_size == 0)
+  {
+    std::invalid_argument ex("io_context_pool size is 0");
+    detail::throw_exception(ex);
+  }
+
+  io_contexts_.reserve(pool_size);
+  work_.reserve(pool_size);
+  for (std::size_t i = 0; i < pool_size; ++i)
+  {
+    detail::shared_ptr<io_context> ctx(new io_context(1));
+    io_contexts_.push_back(ctx);
+    work_.push_back(executor_work_guard<io_context::executor_type>(
+          ctx->get_executor()));
+  }
+
+  // Assign the threads to the CPUs this process is allowed to run on. If
+  // there are more threads than CPUs, they are left unpinned.
+  std::vector<int> cpus;
+#if defined(__linux__) && defined(NET_TS_HAS_PTHREADS)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &allowed))
+        cpus.push_back(cpu);
+#endif // defined(__linux__) && defined(NET_TS_HAS_PTHREADS)
+  if (cpus.size() < pool_size)
+    cpus.clear();
+
+  // If a thread cannot be created, the threads that have already started
+  // must be stopped and joined before the exception leaves the constructor.
+  // Otherwise the thread group's destructor would wait for threads that are
+  // kept running by the work guards.
+#if !defined(NET_TS_NO_EXCEPTIONS)
+  try
+#endif // !defined(NET_TS_NO_EXCEPTIONS)
+  {
+    for (std::size_t i = 0; i < pool_size; ++i)
+    {
+      thread_function f = { io_contexts_[i].get(),
+        cpus.empty() ? -1 : cpus[i] };
+      threads_.create_thread(f);
+    }
+  }
+#if !defined(NET_TS_NO_EXCEPTIONS)
+  catch (...)
+  {
+    stop();
+    join();
+    throw;
+  }
+#endif // !defined(NET_TS_NO_EXCEPTIONS)
+}
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_IMPL_IO_CONTEXT_POOL_IPP
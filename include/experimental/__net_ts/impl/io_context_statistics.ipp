@@ -0,0 +1,96 @@
+//
+// impl/io_context_statistics.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IMPL_IO_CONTEXT_STATISTICS_IPP
+#define NET_TS_IMPL_IO_CONTEXT_STATISTICS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <cstdio>
+#include <ostream>
+#include <experimental/__net_ts/io_context_statistics.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+namespace detail {
+
+// Values are formatted here rather than by the stream, so that the output
+// does not depend on the stream's flags or precision.
+inline void write_prometheus_metric(std::ostream& os, const char* prefix,
+    const char* name, const char* type, const char* help, const char* value)
+{
+  os << "# HELP " << prefix << '_' << name << ' ' << help << '\n';
+  os << "# TYPE " << prefix << '_' << name << ' ' << type << '\n';
+  os << prefix << '_' << name << ' ' << value << '\n';
+}
+
+inline void write_prometheus_metric(std::ostream& os, const char* prefix,
+    const char* name, const char* type, const char* help, uint64_t value)
+{
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%llu",
+      static_cast<unsigned long long>(value));
+  write_prometheus_metric(os, prefix, name, type, help, buf);
+}
+
+// Write a duration in seconds, keeping every nanosecond however large the
+// total grows.
+inline void write_prometheus_seconds(std::ostream& os, const char* prefix,
+    const char* name, const char* help, uint64_t nanoseconds)
+{
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%llu.%09llu",
+      static_cast<unsigned long long>(nanoseconds / 1000000000),
+      static_cast<unsigned long long>(nanoseconds % 1000000000));
+  write_prometheus_metric(os, prefix, name, "counter", help, buf);
+}
+
+} // namespace detail
+
+void io_context_statistics::write_prometheus(
+    std::ostream& os, const char* prefix) const
+{
+  detail::write_prometheus_metric(os, prefix, "queued_handlers", "gauge",
+      "Handlers ready to run.", queued_handlers);
+  detail::write_prometheus_metric(os, prefix, "outstanding_work", "gauge",
+      "Unfinished units of work.", outstanding_work);
+
+  if (!counters_enabled)
+    return;
+
+  detail::write_prometheus_metric(os, prefix, "handlers_executed_total",
+      "counter", "Handlers executed.", handlers_executed);
+  detail::write_prometheus_metric(os, prefix, "reactor_runs_total",
+      "counter", "Times the reactor was run.", reactor_runs);
+  detail::write_prometheus_metric(os, prefix, "reactor_events_total",
+      "counter", "Ready descriptors and expired timers found by the reactor.",
+      reactor_events);
+  detail::write_prometheus_seconds(os, prefix, "blocked_seconds_total",
+      "Time spent blocked waiting for work.", blocked_nanoseconds);
+  detail::write_prometheus_seconds(os, prefix, "running_seconds_total",
+      "Time spent running handlers and polling the reactor.",
+      running_nanoseconds);
+}
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_IMPL_IO_CONTEXT_STATISTICS_IPP
@@ -18,6 +18,7 @@
 #include <experimental/__net_ts/detail/config.hpp>
 #include <experimental/__net_ts/associated_allocator.hpp>
 #include <experimental/__net_ts/associated_executor.hpp>
+#include <experimental/__net_ts/detail/is_executor.hpp>
 #include <experimental/__net_ts/detail/work_dispatcher.hpp>
 
 #include <experimental/__net_ts/detail/push_options.hpp>
@@ -75,6 +76,44 @@ inline NET_TS_INITFN_RESULT_TYPE(CompletionToken, void()) post(
       NET_TS_MOVE_CAST(CompletionToken)(token));
 }
 
+namespace detail {
+
+template <typename Executor, typename InputIterator>
+inline void post_bulk(Executor& ex,
+    InputIterator first, InputIterator last, true_type)
+{
+  ex.post_batch(first, last, std::allocator<void>());
+}
+
+template <typename Executor, typename InputIterator>
+inline void post_bulk(Executor& ex,
+    InputIterator first, InputIterator last, false_type)
+{
+  for (; first != last; ++first)
+    ex.post(*first, std::allocator<void>());
+}
+
+} // namespace detail
+
+template <typename Executor, typename InputIterator>
+inline void post_bulk(const Executor& ex,
+    InputIterator first, InputIterator last,
+    typename enable_if<is_executor<Executor>::value>::type*)
+{
+  Executor ex1(ex);
+  detail::post_bulk(ex1, first, last,
+      integral_constant<bool, detail::has_post_batch<Executor>::value>());
+}
+
+template <typename ExecutionContext, typename InputIterator>
+inline void post_bulk(ExecutionContext& ctx,
+    InputIterator first, InputIterator last,
+    typename enable_if<is_convertible<
+      ExecutionContext&, execution_context&>::value>::type*)
+{
+  (post_bulk)(ctx.get_executor(), first, last);
+}
+
 } // inline namespace v1
 } // namespace net
 } // namespace experimental
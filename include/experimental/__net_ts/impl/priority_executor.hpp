@@ -0,0 +1,123 @@
+//
+// impl/priority_executor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IMPL_PRIORITY_EXECUTOR_HPP
+#define NET_TS_IMPL_PRIORITY_EXECUTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/executor_op.hpp>
+#include <experimental/__net_ts/detail/fenced_block.hpp>
+#include <experimental/__net_ts/detail/handler_invoke_helpers.hpp>
+#include <experimental/__net_ts/detail/recycling_allocator.hpp>
+#include <experimental/__net_ts/detail/type_traits.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+inline io_context& priority_executor::context() const NET_TS_NOEXCEPT
+{
+  return *io_context_;
+}
+
+inline void priority_executor::on_work_started() const NET_TS_NOEXCEPT
+{
+  io_context_->impl_.work_started();
+}
+
+inline void priority_executor::on_work_finished() const NET_TS_NOEXCEPT
+{
+  io_context_->impl_.work_finished();
+}
+
+template <typename Function, typename Allocator>
+void priority_executor::dispatch(
+    NET_TS_MOVE_ARG(Function) f, const Allocator& a) const
+{
+  // Make a local, non-const copy of the function.
+  typedef typename decay<Function>::type function_type;
+  function_type tmp(NET_TS_MOVE_CAST(Function)(f));
+
+  // Invoke immediately if we are already inside the thread pool.
+  if (io_context_->impl_.can_dispatch())
+  {
+    detail::fenced_block b(detail::fenced_block::full);
+    networking_ts_handler_invoke_helpers::invoke(tmp, tmp);
+    return;
+  }
+
+  this->do_post(tmp, a, false, "dispatch");
+}
+
+template <typename Function, typename Allocator>
+void priority_executor::post(
+    NET_TS_MOVE_ARG(Function) f, const Allocator& a) const
+{
+  // Make a local, non-const copy of the function.
+  typedef typename decay<Function>::type function_type;
+  function_type tmp(NET_TS_MOVE_CAST(Function)(f));
+
+  this->do_post(tmp, a, false, "post");
+}
+
+template <typename Function, typename Allocator>
+void priority_executor::defer(
+    NET_TS_MOVE_ARG(Function) f, const Allocator& a) const
+{
+  // Make a local, non-const copy of the function.
+  typedef typename decay<Function>::type function_type;
+  function_type tmp(NET_TS_MOVE_CAST(Function)(f));
+
+  this->do_post(tmp, a, true, "defer");
+}
+
+inline bool
+priority_executor::running_in_this_thread() const NET_TS_NOEXCEPT
+{
+  return io_context_->impl_.can_dispatch();
+}
+
+template <typename Function, typename Allocator>
+void priority_executor::do_post(Function& f, const Allocator& a,
+    bool is_continuation, const char* name) const
+{
+  // Construct an allocator to be used for the operation.
+  typedef typename detail::get_recycling_allocator<Allocator>::type alloc_type;
+  alloc_type allocator(detail::get_recycling_allocator<Allocator>::get(a));
+
+  // Allocate and construct an operation to wrap the function.
+  typedef detail::executor_op<Function, alloc_type, detail::operation> op;
+  typename op::ptr p = { allocator, 0, 0 };
+  p.v = p.a.allocate(1);
+  p.p = new (p.v) op(f, allocator);
+
+  NET_TS_HANDLER_CREATION((this->context(), *p.p,
+        "priority_executor", io_context_, 0, name));
+  (void)name;
+
+  io_context_->impl_.post_priority_completion(
+      p.p, priority_, is_continuation);
+  p.v = p.p = 0;
+}
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_IMPL_PRIORITY_EXECUTOR_HPP
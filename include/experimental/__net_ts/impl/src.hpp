@@ -19,11 +19,13 @@
 # error Do not compile Asio library source with NET_TS_HEADER_ONLY defined
 #endif
 
+#include <experimental/__net_ts/impl/coarse_steady_clock.ipp>
 #include <experimental/__net_ts/impl/error.ipp>
 #include <experimental/__net_ts/impl/execution_context.ipp>
 #include <experimental/__net_ts/impl/executor.ipp>
 #include <experimental/__net_ts/impl/handler_alloc_hook.ipp>
 #include <experimental/__net_ts/impl/io_context.ipp>
+#include <experimental/__net_ts/impl/io_context_pool.ipp>
 #include <experimental/__net_ts/impl/system_executor.ipp>
 #include <experimental/__net_ts/impl/thread_pool.ipp>
 #include <experimental/__net_ts/detail/impl/buffer_sequence_adapter.ipp>
@@ -32,6 +34,7 @@
 #include <experimental/__net_ts/detail/impl/epoll_reactor.ipp>
 #include <experimental/__net_ts/detail/impl/eventfd_select_interrupter.ipp>
 #include <experimental/__net_ts/detail/impl/handler_tracking.ipp>
+#include <experimental/__net_ts/detail/impl/io_uring_reactor.ipp>
 #include <experimental/__net_ts/detail/impl/kqueue_reactor.ipp>
 #include <experimental/__net_ts/detail/impl/null_event.ipp>
 #include <experimental/__net_ts/detail/impl/pipe_select_interrupter.ipp>
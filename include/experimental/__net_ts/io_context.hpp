@@ -24,6 +24,7 @@
 #include <experimental/__net_ts/detail/wrapped_handler.hpp>
 #include <system_error>
 #include <experimental/__net_ts/execution_context.hpp>
+#include <experimental/__net_ts/io_context_statistics.hpp>
 
 #if defined(NET_TS_HAS_CHRONO)
 # include <experimental/__net_ts/detail/chrono.hpp>
@@ -52,6 +53,8 @@ namespace detail {
 #endif
 } // namespace detail
 
+class priority_executor;
+
 /// Provides core I/O functionality.
 /**
  * The io_context class provides the core I/O functionality for users of the
@@ -160,6 +163,7 @@ private:
 public:
   class executor_type;
   friend class executor_type;
+  friend class priority_executor;
 
   class service;
 
@@ -369,6 +373,59 @@ public:
    */
   NET_TS_DECL void restart();
 
+#if defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Set how long idle threads spin before blocking.
+  /**
+   * By default, a thread running the io_context blocks as soon as it finds
+   * no handlers ready to run, and must be woken by the thread that makes the
+   * next handler ready. This function causes such a thread to instead keep
+   * polling for ready handlers, and for I/O readiness, for up to the
+   * specified duration before it blocks. This reduces the latency with which
+   * a newly ready handler is run, at the cost of CPU time.
+   *
+   * @param spin_time The duration for which an idle thread spins. A zero or
+   * negative duration restores the default behaviour. A positive duration
+   * shorter than one microsecond is rounded up to one microsecond.
+   *
+   * While full polling is enabled, idle threads never block and this setting
+   * has no effect. It takes effect again once full polling is disabled.
+   *
+   * @note This function has no effect on Windows, where idle threads always
+   * block on the I/O completion port.
+   */
+  template <typename Rep, typename Period>
+  void set_idle_spin(const chrono::duration<Rep, Period>& spin_time);
+#endif // defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+  /// Enable or disable full polling.
+  /**
+   * When full polling is enabled, threads running the io_context never block.
+   * Idle threads keep polling for ready handlers, and the operating system is
+   * polled for I/O readiness with a zero timeout. Wakeup latency is minimised,
+   * but each thread running the io_context consumes a whole CPU, so full
+   * polling should be used only when there is a dedicated CPU for each thread.
+   *
+   * @param enable If @c false, idle threads go back to spinning for the
+   * duration set by set_idle_spin(), if any, before they block.
+   *
+   * @note This function has no effect on Windows, where idle threads always
+   * block on the I/O completion port.
+   */
+  NET_TS_DECL void set_full_polling(bool enable);
+
+  /// Take a snapshot of the io_context's runtime statistics.
+  /**
+   * This function may be called from any thread, for example to serve a
+   * Prometheus scrape with io_context_statistics::write_prometheus(). It
+   * briefly locks the io_context's queue to count the ready handlers, and
+   * adds together the counters of the threads running the io_context.
+   *
+   * If the io_context was constructed with a concurrency hint that disables
+   * locking of the scheduler, this function must only be called from a thread
+   * that is running the io_context.
+   */
+  NET_TS_DECL io_context_statistics statistics() const;
+
 private:
   // Helper function to add the implementation.
   NET_TS_DECL impl_type& add_impl(impl_type* impl);
@@ -445,6 +502,27 @@ public:
   template <typename Function, typename Allocator>
   void post(NET_TS_MOVE_ARG(Function) f, const Allocator& a) const;
 
+  /// Request the io_context to invoke each of a range of function objects.
+  /**
+   * This function is equivalent to calling @c post() for each element of the
+   * range, in order, except that the function objects are handed to the
+   * io_context together. The io_context's lock is acquired once for the
+   * whole range, and at most one idle thread is woken directly. Other idle
+   * threads are woken by that thread, as for any queue of ready handlers.
+   *
+   * @param first An iterator to the first function object to be called. The
+   * executor makes a copy of each function object. The function signature of
+   * the function objects must be: @code void function(); @endcode
+   *
+   * @param last An iterator one past the last function object to be called.
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename InputIterator, typename Allocator>
+  void post_batch(InputIterator first, InputIterator last,
+      const Allocator& a) const;
+
   /// Request the io_context to invoke the given function object.
   /**
    * This function is used to ask the io_context to execute the given function
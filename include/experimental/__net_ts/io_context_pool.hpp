@@ -0,0 +1,175 @@
+//
+// io_context_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IO_CONTEXT_POOL_HPP
+#define NET_TS_IO_CONTEXT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <experimental/__net_ts/basic_socket_acceptor.hpp>
+#include <experimental/__net_ts/executor_work_guard.hpp>
+#include <experimental/__net_ts/io_context.hpp>
+#include <experimental/__net_ts/socket_base.hpp>
+#include <experimental/__net_ts/detail/atomic_count.hpp>
+#include <experimental/__net_ts/detail/memory.hpp>
+#include <experimental/__net_ts/detail/noncopyable.hpp>
+#include <experimental/__net_ts/detail/thread_group.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// A pool of io_context objects, each run by its own thread.
+/**
+ * The io_context_pool class implements a thread-per-core design. Each
+ * io_context in the pool is constructed with a concurrency hint of 1 and is
+ * run by exactly one thread. Where the platform supports it, the thread is
+ * pinned to a single CPU.
+ *
+ * Objects that are created on one of the pool's io_context objects are
+ * serviced only by that io_context's thread. Incoming connections can be
+ * spread across the pool by opening one acceptor per io_context, all bound to
+ * the same endpoint with the socket_base::reuse_port option set. The kernel
+ * then distributes connections between the acceptors, and no handoff between
+ * threads is needed.
+ *
+ * The threads are started by the constructor and keep running until stop()
+ * is called or, after join() is called, until each io_context runs out of
+ * work.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe, with the exception that calling join() or
+ * destroying the pool concurrently with other member functions is not safe.
+ *
+ * @par Example
+ * Accepting connections on all io_context objects in the pool:
+ * @code
+ * std::experimental::net::io_context_pool pool(4);
+ * std::vector<tcp::acceptor> acceptors =
+ *   pool.open_acceptors<tcp>(tcp::endpoint(tcp::v4(), 8080));
+ * for (std::size_t i = 0; i < acceptors.size(); ++i)
+ *   start_accept(acceptors[i]);
+ * pool.join();
+ * @endcode
+ */
+class io_context_pool
+  : private noncopyable
+{
+public:
+  /// Constructs a pool with one io_context for each CPU.
+  NET_TS_DECL io_context_pool();
+
+  /// Constructs a pool with the specified number of io_context objects.
+  NET_TS_DECL explicit io_context_pool(std::size_t pool_size);
+
+  /// Destructor.
+  /**
+   * Automatically stops and then joins the pool.
+   */
+  NET_TS_DECL ~io_context_pool();
+
+  /// Get the number of io_context objects in the pool.
+  std::size_t size() const NET_TS_NOEXCEPT
+  {
+    return io_contexts_.size();
+  }
+
+  /// Get the io_context object at the specified index.
+  io_context& get_io_context(std::size_t index)
+  {
+    return *io_contexts_[index];
+  }
+
+  /// Get an io_context object from the pool, chosen in round-robin order.
+  NET_TS_DECL io_context& get_io_context();
+
+  /// Stop the io_context objects in the pool.
+  /**
+   * This function stops each io_context in the pool as soon as possible. The
+   * threads that run them exit once their current handlers have returned.
+   */
+  NET_TS_DECL void stop();
+
+  /// Joins the threads.
+  /**
+   * This function lets each io_context run until it has no more work, and
+   * then blocks until all of the threads in the pool have exited.
+   */
+  NET_TS_DECL void join();
+
+#if defined(NET_TS_OS_DEF_SO_REUSEPORT) || defined(GENERATING_DOCUMENTATION)
+  /// Open one listening acceptor on each io_context in the pool.
+  /**
+   * This function opens an acceptor for each io_context, with both the
+   * socket_base::reuse_address and socket_base::reuse_port options set. It
+   * binds each acceptor to the specified endpoint and starts listening. If
+   * the endpoint's port is 0, the port chosen for the first acceptor is used
+   * for all the others.
+   *
+   * @param endpoint The endpoint to which the acceptors will be bound.
+   *
+   * @param backlog The maximum length of each acceptor's queue of pending
+   * connections.
+   *
+   * @returns The acceptors, where the acceptor at index @c i is associated
+   * with get_io_context(i).
+   *
+   * @throws std::system_error Thrown on failure.
+   */
+  template <typename Protocol>
+  std::vector<basic_socket_acceptor<Protocol> > open_acceptors(
+      const typename Protocol::endpoint& endpoint,
+      int backlog = socket_base::max_listen_connections);
+#endif // defined(NET_TS_OS_DEF_SO_REUSEPORT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+private:
+  // Create the io_context objects and start one thread for each.
+  NET_TS_DECL void start(std::size_t pool_size);
+
+  // Function object used to run one io_context of the pool.
+  struct thread_function;
+  friend struct thread_function;
+
+  // The io_context objects in the pool.
+  std::vector<detail::shared_ptr<io_context> > io_contexts_;
+
+  // Keep each io_context running until join() is called.
+  std::vector<executor_work_guard<io_context::executor_type> > work_;
+
+  // The threads running the io_context objects.
+  detail::thread_group threads_;
+
+  // The index of the next io_context to be returned by get_io_context().
+  detail::atomic_count next_io_context_;
+};
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#include <experimental/__net_ts/impl/io_context_pool.hpp>
+#if defined(NET_TS_HEADER_ONLY)
+# include <experimental/__net_ts/impl/io_context_pool.ipp>
+#endif // defined(NET_TS_HEADER_ONLY)
+
+#endif // NET_TS_IO_CONTEXT_POOL_HPP
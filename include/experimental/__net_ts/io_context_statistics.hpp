@@ -0,0 +1,98 @@
+//
+// io_context_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_IO_CONTEXT_STATISTICS_HPP
+#define NET_TS_IO_CONTEXT_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <experimental/__net_ts/detail/cstdint.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// A snapshot of the runtime statistics of an io_context.
+/**
+ * The queue depth and outstanding work are always available. The remaining
+ * counters are maintained only if the program is compiled with
+ * @c NET_TS_ENABLE_IO_CONTEXT_STATISTICS defined, and are otherwise zero.
+ * When enabled, each thread running the io_context updates its own counters
+ * without locking, and the counters of all threads are added together only
+ * when a snapshot is taken.
+ *
+ * Counters are cumulative from the construction of the io_context, and
+ * include threads that have since returned from run(), run_one(), poll() or
+ * poll_one().
+ */
+struct io_context_statistics
+{
+  /// Whether the counters are maintained.
+  bool counters_enabled;
+
+  /// The number of handlers that have been executed.
+  uint64_t handlers_executed;
+
+  /// The number of handlers that are ready to run but have not yet started.
+  std::size_t queued_handlers;
+
+  /// The number of unfinished units of work, including pending asynchronous
+  /// operations and work guards.
+  std::size_t outstanding_work;
+
+  /// The number of times the reactor has been run to wait for, or poll for,
+  /// events.
+  uint64_t reactor_runs;
+
+  /// The number of events found by the reactor, counting each ready
+  /// descriptor and each expired timer.
+  uint64_t reactor_events;
+
+  /// The total time, in nanoseconds, that threads have spent blocked waiting
+  /// for handlers or events.
+  uint64_t blocked_nanoseconds;
+
+  /// The total time, in nanoseconds, that threads have spent executing
+  /// handlers or polling the reactor.
+  uint64_t running_nanoseconds;
+
+  /// Write the statistics in the Prometheus text exposition format.
+  /**
+   * Each statistic is written as a separate metric family with its
+   * @c HELP and @c TYPE lines.
+   *
+   * @param os The stream to which the metrics are written.
+   *
+   * @param prefix The prefix to use for the metric names.
+   */
+  NET_TS_DECL void write_prometheus(std::ostream& os,
+      const char* prefix = "io_context") const;
+};
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#if defined(NET_TS_HEADER_ONLY)
+# include <experimental/__net_ts/impl/io_context_statistics.ipp>
+#endif // defined(NET_TS_HEADER_ONLY)
+
+#endif // NET_TS_IO_CONTEXT_STATISTICS_HPP
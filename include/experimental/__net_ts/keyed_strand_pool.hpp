@@ -0,0 +1,152 @@
+//
+// keyed_strand_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_KEYED_STRAND_POOL_HPP
+#define NET_TS_KEYED_STRAND_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <experimental/__net_ts/detail/cstdint.hpp>
+#include <experimental/__net_ts/strand.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// A fixed pool of strands that provides ordered execution per key.
+/**
+ * The keyed_strand_pool class template maps each key to one of a fixed number
+ * of strands, created when the pool is constructed. All function objects
+ * submitted for the same key are run on the same strand, and so are executed
+ * in order and never concurrently. Function objects for different keys may
+ * share a strand, in which case they are also serialised with respect to each
+ * other.
+ *
+ * This allows ordering to be kept for a very large number of logical entities
+ * without creating a strand for each one.
+ *
+ * @par Example
+ * @code keyed_strand_pool<io_context::executor_type> pool(
+ *     my_io_context.get_executor(), 256);
+ * ...
+ * post(pool.get_executor(order_id), handle_order); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe, provided the pool is not assigned to.
+ */
+template <typename Executor>
+class keyed_strand_pool
+{
+public:
+  /// The type of the underlying executor.
+  typedef Executor inner_executor_type;
+
+  /// The type of the executor used for each key.
+  typedef strand<Executor> executor_type;
+
+  /// The default number of strands in a pool.
+  static const std::size_t default_size = 128;
+
+  /// Construct a pool of strands for the specified executor.
+  /**
+   * @param e The underlying executor on which the strands run.
+   *
+   * @param size The number of strands in the pool. A value of zero is
+   * treated as one.
+   */
+  explicit keyed_strand_pool(const Executor& e,
+      std::size_t size = default_size)
+  {
+    strands_.reserve(size ? size : 1);
+    for (std::size_t i = 0, n = (size ? size : 1); i < n; ++i)
+      strands_.push_back(executor_type(e));
+  }
+
+  /// Obtain the underlying executor.
+  inner_executor_type get_inner_executor() const NET_TS_NOEXCEPT
+  {
+    return strands_[0].get_inner_executor();
+  }
+
+  /// Get the number of strands in the pool.
+  std::size_t size() const NET_TS_NOEXCEPT
+  {
+    return strands_.size();
+  }
+
+  /// Get the strand used for the specified key.
+  /**
+   * The key is hashed using @c std::hash<Key>.
+   */
+  template <typename Key>
+  const executor_type& get_executor(const Key& key) const
+  {
+    return strand_for_hash(std::hash<Key>()(key));
+  }
+
+  /// Get the strand used for the specified key, using a custom hash.
+  template <typename Key, typename Hash>
+  const executor_type& get_executor(const Key& key, const Hash& hash) const
+  {
+    return strand_for_hash(static_cast<std::size_t>(hash(key)));
+  }
+
+  /// Get the strand used for the specified hash value.
+  const executor_type& strand_for_hash(std::size_t hash) const NET_TS_NOEXCEPT
+  {
+    return strands_[index_for_hash(hash)];
+  }
+
+  /// Get the strand at the specified position in the pool.
+  const executor_type& operator[](std::size_t index) const NET_TS_NOEXCEPT
+  {
+    return strands_[index];
+  }
+
+private:
+  // Get the index of the strand used for a hash value. The standard hashes
+  // for integers are often the identity, so the bits are mixed before the
+  // value is reduced to the size of the pool. The 64-bit finalizer from
+  // MurmurHash3 lets every bit of the hash reach the low bits.
+  std::size_t index_for_hash(std::size_t hash) const NET_TS_NOEXCEPT
+  {
+    uint64_t h = static_cast<uint64_t>(hash);
+    h ^= h >> 33;
+    h *= static_cast<uint64_t>(0xff51afd7ed558ccdULL);
+    h ^= h >> 33;
+    h *= static_cast<uint64_t>(0xc4ceb9fe1a85ec53ULL);
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h % strands_.size());
+  }
+
+  std::vector<executor_type> strands_;
+};
+
+template <typename Executor>
+const std::size_t keyed_strand_pool<Executor>::default_size;
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_KEYED_STRAND_POOL_HPP
@@ -101,6 +101,31 @@ NET_TS_INITFN_RESULT_TYPE(CompletionToken, void()) post(
     typename enable_if<is_convertible<
       ExecutionContext&, execution_context&>::value>::type* = 0);
 
+/// Submits a range of function objects for execution.
+/**
+ * This function submits each function object in the range for execution
+ * using the specified executor, in order. The function objects are queued for
+ * execution, and none is called from the current thread prior to returning
+ * from <tt>post_bulk()</tt>.
+ *
+ * If the executor provides a <tt>post_batch()</tt> member function, performs
+ * <tt>ex.post_batch(first, last, std::allocator<void>())</tt>. Otherwise,
+ * performs <tt>ex.post(*i, std::allocator<void>())</tt> for each iterator
+ * @c i in the range <tt>[first, last)</tt>.
+ */
+template <typename Executor, typename InputIterator>
+void post_bulk(const Executor& ex, InputIterator first, InputIterator last,
+    typename enable_if<is_executor<Executor>::value>::type* = 0);
+
+/// Submits a range of function objects for execution.
+/**
+ * @returns <tt>post_bulk(ctx.get_executor(), first, last)</tt>.
+ */
+template <typename ExecutionContext, typename InputIterator>
+void post_bulk(ExecutionContext& ctx, InputIterator first, InputIterator last,
+    typename enable_if<is_convertible<
+      ExecutionContext&, execution_context&>::value>::type* = 0);
+
 } // inline namespace v1
 } // namespace net
 } // namespace experimental
@@ -0,0 +1,198 @@
+//
+// priority_executor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_PRIORITY_EXECUTOR_HPP
+#define NET_TS_PRIORITY_EXECUTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <experimental/__net_ts/io_context.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// Executor used to submit functions to an io_context with a priority.
+/**
+ * The priority_executor class submits function objects to one of three
+ * queues in the io_context:
+ *
+ * @li @c high: Run ahead of all other ready handlers. To avoid starving the
+ * io_context's reactor, at most a small, fixed number of high priority
+ * handlers are run in succession while other operations are waiting.
+ *
+ * @li @c normal: The queue used by io_context::executor_type, and by all
+ * completion handlers of asynchronous operations.
+ *
+ * @li @c background: Run only when there are no normal priority handlers
+ * ready to run. Background handlers alternate with the reactor, so that
+ * neither starves the other.
+ *
+ * Handlers of the same priority are run in the order in which they were
+ * submitted. Priorities are not supported when the io_context is implemented
+ * using an I/O completion port, in which case all handlers are treated as
+ * having @c normal priority.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * Running health checks ahead of bulk data handlers:
+ * @code
+ * std::experimental::net::priority_executor control(
+ *     io_context, std::experimental::net::priority_executor::high);
+ * std::experimental::net::post(control, check_health);
+ * @endcode
+ */
+class priority_executor
+{
+public:
+  /// The queues to which function objects may be submitted.
+  enum priority_type { high = 0, normal = 1, background = 2 };
+
+  /// Construct an executor for the specified io_context and priority.
+  priority_executor(io_context& ctx, priority_type p) NET_TS_NOEXCEPT
+    : io_context_(&ctx),
+      priority_(p)
+  {
+  }
+
+  /// Construct an executor for the io_context of another executor.
+  priority_executor(const io_context::executor_type& ex,
+      priority_type p) NET_TS_NOEXCEPT
+    : io_context_(&ex.context()),
+      priority_(p)
+  {
+  }
+
+  /// Obtain the priority with which function objects are submitted.
+  priority_type priority() const NET_TS_NOEXCEPT
+  {
+    return priority_;
+  }
+
+  /// Obtain an executor for the same io_context with another priority.
+  priority_executor with_priority(priority_type p) const NET_TS_NOEXCEPT
+  {
+    return priority_executor(*io_context_, p);
+  }
+
+  /// Obtain the underlying execution context.
+  io_context& context() const NET_TS_NOEXCEPT;
+
+  /// Inform the io_context that it has some outstanding work to do.
+  void on_work_started() const NET_TS_NOEXCEPT;
+
+  /// Inform the io_context that some work is no longer outstanding.
+  void on_work_finished() const NET_TS_NOEXCEPT;
+
+  /// Request the io_context to invoke the given function object.
+  /**
+   * If the current thread is running the io_context, @c dispatch() executes
+   * the function before returning, regardless of the executor's priority.
+   * Otherwise, the function is queued as if by @c post().
+   *
+   * @param f The function object to be called. The executor will make a copy
+   * of the handler object as required. The function signature of the function
+   * object must be: @code void function(); @endcode
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename Function, typename Allocator>
+  void dispatch(NET_TS_MOVE_ARG(Function) f, const Allocator& a) const;
+
+  /// Request the io_context to invoke the given function object.
+  /**
+   * The function object is queued with the executor's priority, and will
+   * never be executed inside @c post().
+   *
+   * @param f The function object to be called. The executor will make a copy
+   * of the handler object as required. The function signature of the function
+   * object must be: @code void function(); @endcode
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename Function, typename Allocator>
+  void post(NET_TS_MOVE_ARG(Function) f, const Allocator& a) const;
+
+  /// Request the io_context to invoke the given function object.
+  /**
+   * The function object is queued with the executor's priority, and will
+   * never be executed inside @c defer(). For @c normal priority, if the
+   * current thread belongs to the io_context, scheduling is delayed until the
+   * current thread returns control to the pool.
+   *
+   * @param f The function object to be called. The executor will make a copy
+   * of the handler object as required. The function signature of the function
+   * object must be: @code void function(); @endcode
+   *
+   * @param a An allocator that may be used by the executor to allocate the
+   * internal storage needed for function invocation.
+   */
+  template <typename Function, typename Allocator>
+  void defer(NET_TS_MOVE_ARG(Function) f, const Allocator& a) const;
+
+  /// Determine whether the io_context is running in the current thread.
+  bool running_in_this_thread() const NET_TS_NOEXCEPT;
+
+  /// Compare two executors for equality.
+  /**
+   * Two executors are equal if they refer to the same underlying io_context
+   * and have the same priority.
+   */
+  friend bool operator==(const priority_executor& a,
+      const priority_executor& b) NET_TS_NOEXCEPT
+  {
+    return a.io_context_ == b.io_context_ && a.priority_ == b.priority_;
+  }
+
+  /// Compare two executors for inequality.
+  /**
+   * Two executors are equal if they refer to the same underlying io_context
+   * and have the same priority.
+   */
+  friend bool operator!=(const priority_executor& a,
+      const priority_executor& b) NET_TS_NOEXCEPT
+  {
+    return a.io_context_ != b.io_context_ || a.priority_ != b.priority_;
+  }
+
+private:
+  // Helper function to queue an operation with the executor's priority.
+  template <typename Function, typename Allocator>
+  void do_post(Function& f, const Allocator& a,
+      bool is_continuation, const char* name) const;
+
+  // The underlying io_context.
+  io_context* io_context_;
+
+  // The priority with which function objects are submitted.
+  priority_type priority_;
+};
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#include <experimental/__net_ts/impl/priority_executor.hpp>
+
+#endif // NET_TS_PRIORITY_EXECUTOR_HPP
@@ -94,6 +94,28 @@ public:
     wait_error
   };
 
+  /// Bitmask type for flags that control how a socket is registered with the
+  /// reactor.
+  /**
+   * For use with basic_socket::set_registration_flags() and
+   * basic_socket_acceptor::set_registration_flags().
+   */
+  typedef int registration_flags;
+
+  /// Register the socket in the default way.
+  NET_TS_STATIC_CONSTANT(int, registration_default = 0);
+
+  /// Wake only one of the reactors waiting on the socket when it becomes
+  /// ready. This is useful when several io_context objects, or several
+  /// processes, wait on a shared listening socket. Out-of-band data is not
+  /// reported for a socket registered in this way.
+  NET_TS_STATIC_CONSTANT(int, registration_exclusive = 1);
+
+  /// Disarm the registration after each readiness event, and re-arm it once
+  /// the event has been processed. This guarantees that the events for the
+  /// socket are processed by one thread at a time.
+  NET_TS_STATIC_CONSTANT(int, registration_one_shot = 2);
+
   /// Socket option to permit sending of broadcast messages.
   /**
    * Implements the SOL_SOCKET/SO_BROADCAST socket option.
@@ -399,6 +421,44 @@ public:
       reuse_address;
 #endif
 
+  /// Socket option to allow several sockets to bind to the same address and
+  /// port.
+  /**
+   * Implements the SOL_SOCKET/SO_REUSEPORT socket option. When a number of
+   * listening sockets are bound to the same endpoint with this option set, the
+   * kernel distributes incoming connections between them. The option is only
+   * available on platforms that define SO_REUSEPORT.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * std::experimental::net::ip::tcp::acceptor acceptor(io_context); 
+   * ...
+   * std::experimental::net::socket_base::reuse_port option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * std::experimental::net::ip::tcp::acceptor acceptor(io_context); 
+   * ...
+   * std::experimental::net::socket_base::reuse_port option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reuse_port;
+#elif defined(NET_TS_OS_DEF_SO_REUSEPORT)
+  typedef std::experimental::net::detail::socket_option::boolean<
+    NET_TS_OS_DEF(SOL_SOCKET), NET_TS_OS_DEF(SO_REUSEPORT)>
+      reuse_port;
+#endif
+
   /// Socket option to specify whether the socket lingers on close if unsent
   /// data is present.
   /**
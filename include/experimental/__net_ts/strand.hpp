@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/detail/config.hpp>
+#include <cstddef>
+#include <experimental/__net_ts/detail/chrono.hpp>
 #include <experimental/__net_ts/detail/strand_executor_service.hpp>
 #include <experimental/__net_ts/detail/type_traits.hpp>
 
@@ -247,6 +249,57 @@ public:
     return detail::strand_executor_service::running_in_this_thread(impl_);
   }
 
+  /// Limit the work performed each time the strand is scheduled.
+  /**
+   * When the strand is scheduled on its underlying executor it runs the
+   * handlers that are ready, and then reschedules itself if more handlers
+   * have been submitted in the meantime. This function bounds each such turn
+   * so that a busy strand does not monopolise a thread, and optionally lets a
+   * turn continue with newly submitted handlers rather than paying for a
+   * round trip through the underlying executor.
+   *
+   * @param max_handlers The maximum number of handlers to run before the
+   * strand yields and is rescheduled. Zero means no limit.
+   *
+   * @param run_inline If @c true, handlers submitted while the strand is
+   * running are run in the same turn when the underlying execution context
+   * has no other handlers ready to run. This is only supported when the
+   * execution context is an io_context, and is otherwise ignored.
+   *
+   * The limits are shared by all copies of the strand. This function must not
+   * be called concurrently with the execution of the strand's handlers on
+   * another thread.
+   */
+  void set_batching(std::size_t max_handlers, bool run_inline = false)
+  {
+    detail::strand_executor_service::set_batching(
+        impl_, max_handlers, 0, run_inline);
+  }
+
+#if defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Limit the work performed each time the strand is scheduled.
+  /**
+   * @param max_handlers The maximum number of handlers to run before the
+   * strand yields and is rescheduled. Zero means no limit.
+   *
+   * @param max_time The time after which the strand yields and is
+   * rescheduled. The check is made between handlers, and at least one handler
+   * is run each turn.
+   *
+   * @param run_inline If @c true, handlers submitted while the strand is
+   * running are run in the same turn when the underlying execution context
+   * has no other handlers ready to run.
+   */
+  template <typename Rep, typename Period>
+  void set_batching(std::size_t max_handlers,
+      const chrono::duration<Rep, Period>& max_time, bool run_inline = false)
+  {
+    detail::strand_executor_service::set_batching(impl_, max_handlers,
+        static_cast<long>(chrono::duration_cast<
+          chrono::microseconds>(max_time).count()), run_inline);
+  }
+#endif // defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two strands for equality.
   /**
    * Two strands are equal if they refer to the same ordered, non-concurrent
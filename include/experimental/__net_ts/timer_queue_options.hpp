@@ -0,0 +1,144 @@
+//
+// timer_queue_options.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2016 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NET_TS_TIMER_QUEUE_OPTIONS_HPP
+#define NET_TS_TIMER_QUEUE_OPTIONS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <experimental/__net_ts/detail/config.hpp>
+#include <cstddef>
+#include <experimental/__net_ts/detail/chrono.hpp>
+
+#include <experimental/__net_ts/detail/push_options.hpp>
+
+namespace std {
+namespace experimental {
+namespace net {
+inline namespace v1 {
+
+/// Options that control how the timers of one type are queued.
+/**
+ * By default, the timers of each type are kept in a heap ordered by expiry
+ * time, and each timer fires as soon as possible after it expires. The
+ * options are applied to a timer type within an io_context using
+ * set_timer_queue_options().
+ */
+class timer_queue_options
+{
+public:
+  /// Construct with the default options.
+  timer_queue_options() NET_TS_NOEXCEPT
+    : wheel_resolution_usec_(0),
+      wheel_slots_(256),
+      wheel_levels_(4),
+      slack_usec_(0)
+  {
+  }
+
+#if defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Order the timers using a hierarchical timing wheel.
+  /**
+   * A timing wheel inserts and cancels timers in constant time, which suits
+   * large numbers of coarse timeouts. Timers fire on the first tick at or
+   * after their expiry, and so may be up to @c resolution late.
+   *
+   * @param resolution The length of a tick. The resolution is limited to
+   * whole microseconds.
+   *
+   * @param slots_per_level The number of slots in each level of the wheel.
+   * This is rounded up to a power of two.
+   *
+   * @param levels The number of levels. The wheel spans
+   * <tt>resolution * pow(slots_per_level, levels)</tt>, and timers beyond
+   * that range are moved as the wheel turns.
+   */
+  template <typename Rep, typename Period>
+  timer_queue_options& use_timer_wheel(
+      const chrono::duration<Rep, Period>& resolution,
+      std::size_t slots_per_level = 256, std::size_t levels = 4)
+  {
+    long usec = static_cast<long>(chrono::duration_cast<
+        chrono::microseconds>(resolution).count());
+    wheel_resolution_usec_ = usec > 0 ? usec : 1;
+    wheel_slots_ = slots_per_level;
+    wheel_levels_ = levels;
+    return *this;
+  }
+
+  /// Allow timers to fire late so that nearby expiries are grouped together.
+  /**
+   * Time is divided into windows of length @c slack, and all timers that
+   * expire within a window are dequeued by a single wake-up at the end of
+   * that window. This reduces the number of times the reactor wakes up and
+   * reprograms its timer when there are many coarse timeouts. Timers never
+   * fire early, and fire at most @c slack late.
+   *
+   * When a timing wheel is also used, the slack is rounded down to a whole
+   * number of ticks.
+   */
+  template <typename Rep, typename Period>
+  timer_queue_options& set_timer_slack(
+      const chrono::duration<Rep, Period>& slack)
+  {
+    long usec = static_cast<long>(chrono::duration_cast<
+        chrono::microseconds>(slack).count());
+    slack_usec_ = usec > 0 ? usec : 0;
+    return *this;
+  }
+#endif // defined(NET_TS_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+  /// Whether a timing wheel is used.
+  bool uses_timer_wheel() const NET_TS_NOEXCEPT
+  {
+    return wheel_resolution_usec_ > 0;
+  }
+
+  /// The length of a timing wheel tick, in microseconds.
+  long timer_wheel_resolution_usec() const NET_TS_NOEXCEPT
+  {
+    return wheel_resolution_usec_;
+  }
+
+  /// The number of slots in each level of the timing wheel.
+  std::size_t timer_wheel_slots() const NET_TS_NOEXCEPT
+  {
+    return wheel_slots_;
+  }
+
+  /// The number of levels in the timing wheel.
+  std::size_t timer_wheel_levels() const NET_TS_NOEXCEPT
+  {
+    return wheel_levels_;
+  }
+
+  /// The slack allowed when firing timers, in microseconds.
+  long timer_slack_usec() const NET_TS_NOEXCEPT
+  {
+    return slack_usec_;
+  }
+
+private:
+  long wheel_resolution_usec_;
+  std::size_t wheel_slots_;
+  std::size_t wheel_levels_;
+  long slack_usec_;
+};
+
+} // inline namespace v1
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include <experimental/__net_ts/detail/pop_options.hpp>
+
+#endif // NET_TS_TIMER_QUEUE_OPTIONS_HPP
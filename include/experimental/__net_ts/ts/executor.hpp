@@ -29,6 +29,7 @@
 #include <experimental/__net_ts/post.hpp>
 #include <experimental/__net_ts/defer.hpp>
 #include <experimental/__net_ts/strand.hpp>
+#include <experimental/__net_ts/keyed_strand_pool.hpp>
 #include <experimental/__net_ts/packaged_task.hpp>
 #include <experimental/__net_ts/use_future.hpp>
 
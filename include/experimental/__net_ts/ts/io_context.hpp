@@ -16,5 +16,6 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <experimental/__net_ts/io_context.hpp>
+#include <experimental/__net_ts/priority_executor.hpp>
 
 #endif // NET_TS_TS_IO_CONTEXT_HPP
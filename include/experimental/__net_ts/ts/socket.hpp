@@ -23,5 +23,6 @@
 #include <experimental/__net_ts/basic_socket_streambuf.hpp>
 #include <experimental/__net_ts/basic_socket_iostream.hpp>
 #include <experimental/__net_ts/connect.hpp>
+#include <experimental/__net_ts/io_context_pool.hpp>
 
 #endif // NET_TS_TS_SOCKET_HPP
@@ -18,9 +18,11 @@
 #include <chrono>
 
 #include <experimental/__net_ts/wait_traits.hpp>
+#include <experimental/__net_ts/timer_queue_options.hpp>
 #include <experimental/__net_ts/basic_waitable_timer.hpp>
 #include <experimental/__net_ts/system_timer.hpp>
 #include <experimental/__net_ts/steady_timer.hpp>
 #include <experimental/__net_ts/high_resolution_timer.hpp>
+#include <experimental/__net_ts/coarse_steady_timer.hpp>
 
 #endif // NET_TS_TS_TIMER_HPP